@@ -79,6 +79,33 @@
     }                                                                  \
   } Object ## type ## param ## RegistrationVariable
 
+/**
+ * \ingroup object
+ * \brief Explicitly instantiate a template class with two template parameters
+ *        and register the resulting instance with the TypeId system.
+ *
+ * Same as NS_OBJECT_TEMPLATE_CLASS_DEFINE, for template classes whose second
+ * template parameter is not the default one (e.g., a Queue storing its items
+ * in a container other than the default one).  Both parameters must be
+ * plain identifiers (use a typedef for other types).  The type parameter
+ * name returned by GetTypeParamName is the name of the first parameter,
+ * hence at most one instance per first parameter can be registered.
+ */
+#define NS_OBJECT_TEMPLATE_CLASS_TWO_DEFINE(type,param1,param2)                \
+  template class type<param1, param2>;                                         \
+  template <> std::string DoGetTypeParamName<type<param1, param2> > ()         \
+  {                                                                            \
+    return #param1;                                                            \
+  }                                                                            \
+  static struct Object ## type ## param1 ## param2 ## RegistrationClass        \
+  {                                                                            \
+    Object ## type ## param1 ## param2 ## RegistrationClass () {               \
+      ns3::TypeId tid = type<param1, param2>::GetTypeId ();                    \
+      tid.SetSize (sizeof (type<param1, param2>));                             \
+      tid.GetParent ();                                                        \
+    }                                                                          \
+  } Object ## type ## param1 ## param2 ## RegistrationVariable
+
 
 namespace ns3 {
 
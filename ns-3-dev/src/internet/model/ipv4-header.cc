@@ -385,11 +385,6 @@ Ipv4Header::Serialize (Buffer::Iterator start) const
   NS_LOG_FUNCTION (this << &start);
   Buffer::Iterator i = start;
 
-  uint8_t verIhl = (4 << 4) | (5);
-  i.WriteU8 (verIhl);
-  i.WriteU8 (m_tos);
-  i.WriteHtonU16 (m_payloadSize + 5*4);
-  i.WriteHtonU16 (m_identification);
   uint32_t fragmentOffset = m_fragmentOffset / 8;
   uint8_t flagsFrag = (fragmentOffset >> 8) & 0x1f;
   if (m_flags & DONT_FRAGMENT) 
@@ -400,14 +395,22 @@ Ipv4Header::Serialize (Buffer::Iterator start) const
     {
       flagsFrag |= (1<<5);
     }
-  i.WriteU8 (flagsFrag);
   uint8_t frag = fragmentOffset & 0xff;
-  i.WriteU8 (frag);
-  i.WriteU8 (m_ttl);
-  i.WriteU8 (m_protocol);
-  i.WriteHtonU16 (0);
-  i.WriteHtonU32 (m_source.Get ());
-  i.WriteHtonU32 (m_destination.Get ());
+
+  // the header has a fixed size: write it as a single block
+  Buffer::BlockWriter w (i, 20);
+  uint8_t verIhl = (4 << 4) | (5);
+  w.WriteU8 (verIhl);
+  w.WriteU8 (m_tos);
+  w.WriteHtonU16 (m_payloadSize + 5*4);
+  w.WriteHtonU16 (m_identification);
+  w.WriteU8 (flagsFrag);
+  w.WriteU8 (frag);
+  w.WriteU8 (m_ttl);
+  w.WriteU8 (m_protocol);
+  w.WriteHtonU16 (0);
+  w.WriteHtonU32 (m_source.Get ());
+  w.WriteHtonU32 (m_destination.Get ());
 
   if (m_calcChecksum) 
     {
@@ -315,14 +315,18 @@ void
 TcpHeader::Serialize (Buffer::Iterator start)  const
 {
   Buffer::Iterator i = start;
-  i.WriteHtonU16 (m_sourcePort);
-  i.WriteHtonU16 (m_destinationPort);
-  i.WriteHtonU32 (m_sequenceNumber.GetValue ());
-  i.WriteHtonU32 (m_ackNumber.GetValue ());
-  i.WriteHtonU16 (GetLength () << 12 | m_flags); //reserved bits are all zero
-  i.WriteHtonU16 (m_windowSize);
-  i.WriteHtonU16 (0);
-  i.WriteHtonU16 (m_urgentPointer);
+  {
+    // the fixed part of the header is written as a single block
+    Buffer::BlockWriter w (i, 20);
+    w.WriteHtonU16 (m_sourcePort);
+    w.WriteHtonU16 (m_destinationPort);
+    w.WriteHtonU32 (m_sequenceNumber.GetValue ());
+    w.WriteHtonU32 (m_ackNumber.GetValue ());
+    w.WriteHtonU16 (GetLength () << 12 | m_flags); //reserved bits are all zero
+    w.WriteHtonU16 (m_windowSize);
+    w.WriteHtonU16 (0);
+    w.WriteHtonU16 (m_urgentPointer);
+  }
 
   // Serialize options if they exist
   // This implementation does not presently try to align options on word
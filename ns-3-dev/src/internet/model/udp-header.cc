@@ -185,20 +185,21 @@ UdpHeader::Serialize (Buffer::Iterator start) const
 {
   Buffer::Iterator i = start;
 
-  i.WriteHtonU16 (m_sourcePort);
-  i.WriteHtonU16 (m_destinationPort);
+  Buffer::BlockWriter w (i, 8);
+  w.WriteHtonU16 (m_sourcePort);
+  w.WriteHtonU16 (m_destinationPort);
   if (m_payloadSize == 0)
     {
-      i.WriteHtonU16 (start.GetSize ());
+      w.WriteHtonU16 (start.GetSize ());
     }
   else
     {
-      i.WriteHtonU16 (m_payloadSize);
+      w.WriteHtonU16 (m_payloadSize);
     }
 
   if ( m_checksum == 0)
     {
-      i.WriteU16 (0);
+      w.WriteU16 (0);
 
       if (m_calcChecksum)
         {
@@ -213,7 +214,7 @@ UdpHeader::Serialize (Buffer::Iterator start) const
     }
   else
     {
-      i.WriteU16 (m_checksum);
+      w.WriteU16 (m_checksum);
     }
 }
 uint32_t
@@ -250,6 +250,19 @@ public:
      */
     void Write (Iterator start, Iterator end);
 
+    /**
+     * \param size number of bytes to write
+     * \return a pointer to the next size bytes of the buffer
+     *
+     * Advance the iterator position by size bytes and return a pointer
+     * to the bytes it moved over, for the caller to write them directly.
+     * The bytes must not be in the "virtual zero area": this is checked
+     * once for the whole block (in debug builds) rather than once per
+     * written field. The pointer is only valid until the buffer is
+     * modified. Headers use it through Buffer::BlockWriter.
+     */
+    inline uint8_t *WriteBlock (uint32_t size);
+
     /**
      * \return the byte read in the buffer.
      *
@@ -484,6 +497,73 @@ private:
     uint8_t *m_data;
   };
 
+  /**
+   * \brief Writes a block of known size through a raw pointer
+   *
+   * Every Buffer::Iterator write checks its position against the "virtual
+   * zero area" and works out where the bytes are stored.  Headers whose
+   * size is known before they are serialized (e.g., the fixed part of the
+   * IPv4, UDP, TCP, PPP and 802.11 MAC headers) can instead obtain the
+   * whole region once and store their fields with plain memory writes:
+   *
+   * \code
+   *   Buffer::BlockWriter w (i, 8);
+   *   w.WriteHtonU16 (m_sourcePort);
+   *   ...
+   * \endcode
+   *
+   * The iterator is moved past the block when the writer is created.  The
+   * fields must fill exactly the size of the block, which is checked in
+   * debug builds.
+   */
+  class BlockWriter
+  {
+public:
+    /**
+     * \param i the iterator pointing to the start of the block; it is
+     *        moved to the end of the block
+     * \param size the size of the block
+     */
+    inline BlockWriter (Iterator &i, uint32_t size);
+    inline ~BlockWriter ();
+    /**
+     * \param data data to write in the block
+     */
+    inline void WriteU8 (uint8_t data);
+    /**
+     * \param data data to write in the block, in the format of
+     *        Buffer::Iterator::WriteU16
+     */
+    inline void WriteU16 (uint16_t data);
+    /**
+     * \param data data to write in the block in network order; the input
+     *        data is expected to be in host order
+     */
+    inline void WriteHtonU16 (uint16_t data);
+    /**
+     * \param data data to write in the block in network order; the input
+     *        data is expected to be in host order
+     */
+    inline void WriteHtonU32 (uint32_t data);
+    /**
+     * \param data data to write in the block in least significant byte
+     *        order; the input data is expected to be in host order
+     */
+    inline void WriteHtolsbU16 (uint16_t data);
+    /**
+     * \param buffer the bytes to copy in the block
+     * \param size the number of bytes to copy
+     */
+    inline void Write (uint8_t const *buffer, uint32_t size);
+
+private:
+    BlockWriter (const BlockWriter &) = delete;
+    BlockWriter & operator = (const BlockWriter &) = delete;
+
+    uint8_t *m_current; //!< where the next byte is written
+    uint8_t *m_end;     //!< end of the block
+  };
+
   /**
    * \return the number of bytes stored in this buffer.
    */
@@ -942,6 +1022,89 @@ Buffer::Iterator::WriteHtonU32 (uint32_t data)
   m_current+= 4;
 }
 
+uint8_t *
+Buffer::Iterator::WriteBlock (uint32_t size)
+{
+  NS_ASSERT_MSG (CheckNoZero (m_current, m_current + size),
+                 GetWriteErrorMessage ());
+  uint8_t *buffer;
+  if (m_current + size <= m_zeroStart)
+    {
+      buffer = &m_data[m_current];
+    }
+  else
+    {
+      buffer = &m_data[m_current - (m_zeroEnd - m_zeroStart)];
+    }
+  m_current += size;
+  return buffer;
+}
+
+Buffer::BlockWriter::BlockWriter (Iterator &i, uint32_t size)
+  : m_current (i.WriteBlock (size)),
+    m_end (m_current + size)
+{
+}
+
+Buffer::BlockWriter::~BlockWriter ()
+{
+  NS_ASSERT_MSG (m_current == m_end, "The block was not filled");
+}
+
+void
+Buffer::BlockWriter::WriteU8 (uint8_t data)
+{
+  NS_ASSERT (m_current + 1 <= m_end);
+  m_current[0] = data;
+  m_current++;
+}
+
+void
+Buffer::BlockWriter::WriteU16 (uint16_t data)
+{
+  NS_ASSERT (m_current + 2 <= m_end);
+  m_current[0] = (data >> 0)& 0xff;
+  m_current[1] = (data >> 8)& 0xff;
+  m_current += 2;
+}
+
+void
+Buffer::BlockWriter::WriteHtonU16 (uint16_t data)
+{
+  NS_ASSERT (m_current + 2 <= m_end);
+  m_current[0] = (data >> 8)& 0xff;
+  m_current[1] = (data >> 0)& 0xff;
+  m_current += 2;
+}
+
+void
+Buffer::BlockWriter::WriteHtonU32 (uint32_t data)
+{
+  NS_ASSERT (m_current + 4 <= m_end);
+  m_current[0] = (data >> 24)& 0xff;
+  m_current[1] = (data >> 16)& 0xff;
+  m_current[2] = (data >> 8)& 0xff;
+  m_current[3] = (data >> 0)& 0xff;
+  m_current += 4;
+}
+
+void
+Buffer::BlockWriter::WriteHtolsbU16 (uint16_t data)
+{
+  NS_ASSERT (m_current + 2 <= m_end);
+  m_current[0] = (data >> 0)& 0xff;
+  m_current[1] = (data >> 8)& 0xff;
+  m_current += 2;
+}
+
+void
+Buffer::BlockWriter::Write (uint8_t const *buffer, uint32_t size)
+{
+  NS_ASSERT (m_current + size <= m_end);
+  std::memcpy (m_current, buffer, size);
+  m_current += size;
+}
+
 uint16_t 
 Buffer::Iterator::ReadNtohU16 (void)
 {
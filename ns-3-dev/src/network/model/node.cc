@@ -187,6 +187,8 @@ Node::DoDispose ()
   NS_LOG_FUNCTION (this);
   m_deviceAdditionListeners.clear ();
   m_handlers.clear ();
+  m_promiscHandlers.clear ();
+  m_dispatchTable.clear ();
   for (std::vector<Ptr<NetDevice> >::iterator i = m_devices.begin ();
        i != m_devices.end (); i++)
     {
@@ -257,6 +259,7 @@ Node::RegisterProtocolHandler (ProtocolHandler handler,
     }
 
   m_handlers.push_back (entry);
+  RebuildProtocolHandlers ();
 }
 
 void
@@ -272,6 +275,51 @@ Node::UnregisterProtocolHandler (ProtocolHandler handler)
           break;
         }
     }
+  RebuildProtocolHandlers ();
+}
+
+void
+Node::RebuildProtocolHandlers (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_promiscHandlers.clear ();
+  for (ProtocolHandlerList::const_iterator i = m_handlers.begin ();
+       i != m_handlers.end (); i++)
+    {
+      if (i->promiscuous)
+        {
+          m_promiscHandlers.push_back (*i);
+        }
+    }
+  // the non-promiscuous entries are filled again on demand
+  m_dispatchTable.clear ();
+}
+
+std::shared_ptr<const Node::ProtocolHandlerVector>
+Node::LookupProtocolHandlers (Ptr<NetDevice> device, uint16_t protocol)
+{
+  uint64_t key = (static_cast<uint64_t> (device->GetIfIndex ()) << 16) | protocol;
+  ProtocolHandlerTable::const_iterator it = m_dispatchTable.find (key);
+  if (it != m_dispatchTable.end ())
+    {
+      return it->second;
+    }
+
+  std::shared_ptr<ProtocolHandlerVector> handlers = std::make_shared<ProtocolHandlerVector> ();
+  for (ProtocolHandlerList::const_iterator i = m_handlers.begin ();
+       i != m_handlers.end (); i++)
+    {
+      if (!i->promiscuous
+          && (i->device == 0 || i->device == device)
+          && (i->protocol == 0 || i->protocol == protocol))
+        {
+          handlers->push_back (i->handler);
+        }
+    }
+  NS_LOG_LOGIC ("Node " << GetId () << ": " << handlers->size () << " handler(s) for device "
+                        << device->GetIfIndex () << " and protocol " << protocol);
+  m_dispatchTable[key] = handlers;
+  return handlers;
 }
 
 bool
@@ -312,22 +360,29 @@ Node::ReceiveFromDevice (Ptr<NetDevice> device, Ptr<const Packet> packet, uint16
                         << ") Packet UID " << packet->GetUid ());
   bool found = false;
 
-  for (ProtocolHandlerList::iterator i = m_handlers.begin ();
-       i != m_handlers.end (); i++)
+  if (promiscuous)
     {
-      if (i->device == 0 ||
-          (i->device != 0 && i->device == device))
+      for (ProtocolHandlerList::iterator i = m_promiscHandlers.begin ();
+           i != m_promiscHandlers.end (); i++)
         {
-          if (i->protocol == 0 || 
-              i->protocol == protocol)
+          if ((i->device == 0 || i->device == device)
+              && (i->protocol == 0 || i->protocol == protocol))
             {
-              if (promiscuous == i->promiscuous)
-                {
-                  i->handler (device, packet, protocol, from, to, packetType);
-                  found = true;
-                }
+              i->handler (device, packet, protocol, from, to, packetType);
+              found = true;
             }
         }
+      return found;
+    }
+
+  // hold a reference to the list: a handler may register or unregister
+  // handlers, which empties the dispatch table
+  std::shared_ptr<const ProtocolHandlerVector> handlers = LookupProtocolHandlers (device, protocol);
+  for (ProtocolHandlerVector::const_iterator i = handlers->begin ();
+       i != handlers->end (); i++)
+    {
+      (*i) (device, packet, protocol, from, to, packetType);
+      found = true;
     }
   return found;
 }
@@ -22,6 +22,8 @@
 #define NODE_H
 
 #include <vector>
+#include <unordered_map>
+#include <memory>
 
 #include "ns3/object.h"
 #include "ns3/callback.h"
@@ -266,6 +268,27 @@ private:
    */
   void Construct (void);
 
+  /// Handlers a packet is delivered to, in registration order
+  typedef std::vector<ProtocolHandler> ProtocolHandlerVector;
+
+  /**
+   * \brief Get the non-promiscuous handlers matching a device and a protocol.
+   *
+   * The handlers are looked up in the dispatch table, which is filled on
+   * demand from the registered handlers.
+   *
+   * \param device the device
+   * \param protocol the protocol
+   * \returns the matching handlers, in registration order
+   */
+  std::shared_ptr<const ProtocolHandlerVector> LookupProtocolHandlers (Ptr<NetDevice> device, uint16_t protocol);
+
+  /**
+   * \brief Rebuild the promiscuous handler list and empty the dispatch table
+   * after a handler has been registered or unregistered.
+   */
+  void RebuildProtocolHandlers (void);
+
   /**
    * \brief Protocol handler entry.
    * This structure is used to demultiplex all the protocols.
@@ -279,6 +302,13 @@ private:
 
   /// Typedef for protocol handlers container
   typedef std::vector<struct Node::ProtocolHandlerEntry> ProtocolHandlerList;
+  /**
+   * Typedef for the dispatch table of the non-promiscuous handlers, indexed
+   * by the device index (upper bits) and the protocol (lower 16 bits).
+   * The lists are shared so that a handler may register or unregister
+   * handlers while a packet is being dispatched.
+   */
+  typedef std::unordered_map<uint64_t, std::shared_ptr<const ProtocolHandlerVector> > ProtocolHandlerTable;
   /// Typedef for NetDevice addition listeners container
   typedef std::vector<DeviceAdditionListener> DeviceAdditionListenerList;
 
@@ -287,6 +317,8 @@ private:
   std::vector<Ptr<NetDevice> > m_devices; //!< Devices associated to this node
   std::vector<Ptr<Application> > m_applications; //!< Applications associated to this node
   ProtocolHandlerList m_handlers; //!< Protocol handlers in the node
+  ProtocolHandlerList m_promiscHandlers; //!< Promiscuous protocol handlers in the node
+  ProtocolHandlerTable m_dispatchTable; //!< Non-promiscuous handlers per device and protocol
   DeviceAdditionListenerList m_deviceAdditionListeners; //!< Device addition listeners in the node
 };
 
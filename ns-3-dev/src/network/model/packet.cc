@@ -30,6 +30,102 @@ NS_LOG_COMPONENT_DEFINE ("Packet");
 
 uint32_t Packet::m_globalUid = 0;
 
+#ifdef PACKET_FREE_LIST
+namespace {
+
+/**
+ * \ingroup packet
+ * \brief A free block of the packet pool.
+ */
+union PacketBlock
+{
+  PacketBlock *next;                                  //!< next free block
+  alignas (Packet) unsigned char data[sizeof (Packet)]; //!< storage for a packet
+};
+
+/**
+ * \ingroup packet
+ * \brief A chunk of packet blocks.
+ */
+struct PacketChunk
+{
+  static const uint32_t N_BLOCKS = 256;  //!< number of blocks per chunk
+  PacketChunk *next;                     //!< next chunk of the pool
+  PacketBlock blocks[N_BLOCKS];          //!< the blocks
+};
+
+/*
+ * The pool only uses zero-initialized plain variables, so that packets can
+ * still be created and deleted while the static objects of the program are
+ * constructed or destroyed.
+ */
+PacketBlock *g_packetFreeList = 0;   //!< free blocks of the pool
+PacketChunk *g_packetChunks = 0;     //!< chunks of the pool
+uint64_t g_packetLiveBlocks = 0;     //!< blocks currently used by a packet
+
+/**
+ * \ingroup packet
+ * \brief Release the packet pool when the program exits.
+ */
+struct PacketPoolDestructor
+{
+  ~PacketPoolDestructor ()
+  {
+    // packets which are still referenced (e.g., by other static objects)
+    // keep the whole pool alive
+    if (g_packetLiveBlocks != 0)
+      {
+        return;
+      }
+    while (g_packetChunks != 0)
+      {
+        PacketChunk *chunk = g_packetChunks;
+        g_packetChunks = chunk->next;
+        delete chunk;
+      }
+    g_packetFreeList = 0;
+  }
+} g_packetPoolDestructor; //!< Releases the pool when the program exits
+
+} // unnamed namespace
+
+void *
+Packet::operator new (std::size_t size)
+{
+  NS_ASSERT (size == sizeof (Packet));
+  if (g_packetFreeList == 0)
+    {
+      // carve a new chunk into free blocks, in address order
+      PacketChunk *chunk = new PacketChunk;
+      chunk->next = g_packetChunks;
+      g_packetChunks = chunk;
+      for (uint32_t i = PacketChunk::N_BLOCKS; i > 0; i--)
+        {
+          chunk->blocks[i - 1].next = g_packetFreeList;
+          g_packetFreeList = &chunk->blocks[i - 1];
+        }
+    }
+  PacketBlock *block = g_packetFreeList;
+  g_packetFreeList = block->next;
+  g_packetLiveBlocks++;
+  return block;
+}
+
+void
+Packet::operator delete (void *ptr, std::size_t size)
+{
+  if (ptr == 0)
+    {
+      return;
+    }
+  NS_ASSERT (size == sizeof (Packet));
+  PacketBlock *block = static_cast<PacketBlock *> (ptr);
+  block->next = g_packetFreeList;
+  g_packetFreeList = block;
+  g_packetLiveBlocks--;
+}
+#endif /* PACKET_FREE_LIST */
+
 TypeId 
 ByteTagIterator::Item::GetTypeId (void) const
 {
@@ -34,6 +34,9 @@
 #include "ns3/assert.h"
 #include "ns3/ptr.h"
 #include "ns3/deprecated.h"
+#include <cstddef>
+
+#define PACKET_FREE_LIST 1
 
 namespace ns3 {
 
@@ -710,6 +713,30 @@ public:
    */
   Ptr<NixVector> GetNixVector (void) const; 
 
+#ifdef PACKET_FREE_LIST
+  /**
+   * \brief Allocate the memory of a packet.
+   *
+   * Packets are created and destroyed at a very high rate (every queue,
+   * trace and forwarding step makes copies), so their memory comes from a
+   * pool instead of the general purpose allocator: blocks are carved out
+   * of large chunks, go back to a free list when a packet is deleted and
+   * are reused by the next packet.  The chunks are released in bulk when
+   * the program exits.
+   *
+   * \param size the size of the object
+   * \returns the memory for the packet
+   */
+  static void * operator new (std::size_t size);
+  /**
+   * \brief Give the memory of a packet back to the pool.
+   *
+   * \param ptr the memory of the packet
+   * \param size the size of the object
+   */
+  static void operator delete (void *ptr, std::size_t size);
+#endif /* PACKET_FREE_LIST */
+
   /**
    * TracedCallback signature for Ptr<Packet>
    *
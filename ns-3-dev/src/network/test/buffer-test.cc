@@ -385,6 +385,28 @@ BufferTest::DoRun (void)
   val2 <<= 8;
   val2 |= i.ReadU8 ();
   NS_TEST_ASSERT_MSG_EQ (val1, val2, "Bad ReadNtohU16()");
+
+  // BlockWriter writes the same bytes as the Iterator methods, both
+  // before and after the zero area.
+  buffer = Buffer (5);
+  buffer.AddAtStart (9);
+  buffer.AddAtEnd (2);
+  i = buffer.Begin ();
+  {
+    uint8_t first[] = {0x01};
+    Buffer::BlockWriter w (i, 9);
+    w.Write (first, 1);
+    w.WriteU16 (0x0302);
+    w.WriteHtonU16 (0x0405);
+    w.WriteHtonU32 (0x06070809);
+  }
+  i.Next (5);
+  {
+    Buffer::BlockWriter w (i, 2);
+    w.WriteHtolsbU16 (0x0b0a);
+  }
+  NS_TEST_ASSERT_MSG_EQ (i.IsEnd (), true, "BlockWriter must move the iterator to the end of the block");
+  ENSURE_WRITTEN_BYTES (buffer, 16, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0, 0, 0, 0, 0, 0x0a, 0x0b);
 }
 
 /**
@@ -19,6 +19,9 @@
 #include "ns3/test.h"
 #include "ns3/drop-tail-queue.h"
 #include "ns3/string.h"
+#include "ns3/ring-buffer.h"
+#include <list>
+#include <vector>
 
 using namespace ns3;
 
@@ -83,6 +86,290 @@ DropTailQueueTestCase::DoRun (void)
   NS_TEST_EXPECT_MSG_EQ ((packet == 0), true, "There are really no packets in there");
 }
 
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * Check that a drop tail queue keeps the FIFO order while the ring buffer
+ * storing its items wraps around and grows.
+ */
+class DropTailQueueFifoTestCase : public TestCase
+{
+public:
+  DropTailQueueFifoTestCase ();
+  virtual void DoRun (void);
+};
+
+DropTailQueueFifoTestCase::DropTailQueueFifoTestCase ()
+  : TestCase ("Check the FIFO order of a drop tail queue across ring buffer wrap-arounds")
+{
+}
+
+void
+DropTailQueueFifoTestCase::DoRun (void)
+{
+  Ptr<DropTailQueue<Packet> > queue = CreateObject<DropTailQueue<Packet> > ();
+  NS_TEST_EXPECT_MSG_EQ (queue->SetAttributeFailSafe ("MaxSize", StringValue ("100p")), true,
+                         "Verify that we can actually set the attribute");
+
+  // Keep the occupancy oscillating so that the head of the buffer wraps
+  // around several times while the buffer grows
+  std::vector<Ptr<Packet> > sent;
+  uint32_t nReceived = 0;
+  for (uint32_t round = 0; round < 10; round++)
+    {
+      for (uint32_t i = 0; i < 7 * (round + 1); i++)
+        {
+          sent.push_back (Create<Packet> (i));
+          NS_TEST_EXPECT_MSG_EQ (queue->Enqueue (sent.back ()), true, "Enqueue must succeed");
+        }
+      while (queue->GetNPackets () > 3 * round)
+        {
+          Ptr<const Packet> peeked = queue->Peek ();
+          Ptr<Packet> packet = queue->Dequeue ();
+          NS_TEST_EXPECT_MSG_EQ (packet, peeked, "Peek must return the packet to be dequeued");
+          NS_TEST_EXPECT_MSG_EQ (packet, sent[nReceived], "Packets must be dequeued in FIFO order");
+          nReceived++;
+        }
+    }
+  queue->Flush ();
+  NS_TEST_EXPECT_MSG_EQ (queue->GetNPackets (), 0, "There should be no packets in there");
+  NS_TEST_EXPECT_MSG_EQ (queue->GetTotalDroppedPackets (), sent.size () - nReceived,
+                         "All the packets left in the queue must be dropped by Flush");
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * A FIFO queue which can also remove the item at any position, storing its
+ * items in the given container.
+ */
+template <typename Container>
+class RemoveTestQueue : public Queue<Packet, Container>
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void)
+  {
+    static TypeId tid = TypeId ("ns3::RemoveTestQueue<" + GetTypeParamName<RemoveTestQueue<Container> > () + ">")
+      .SetParent<QueueBase> ()
+      .SetGroupName ("Network")
+    ;
+    return tid;
+  }
+
+  bool Enqueue (Ptr<Packet> item) override
+  {
+    return this->DoEnqueue (this->end (), item);
+  }
+  Ptr<Packet> Dequeue (void) override
+  {
+    return this->DoDequeue (this->begin ());
+  }
+  Ptr<Packet> Remove (void) override
+  {
+    return this->DoRemove (this->begin ());
+  }
+  Ptr<const Packet> Peek (void) const override
+  {
+    return this->DoPeek (this->begin ());
+  }
+  /**
+   * Remove the item at the given position
+   * \param n the position of the item, starting from the head of the queue
+   * \return the removed item
+   */
+  Ptr<Packet> RemoveAt (uint32_t n)
+  {
+    return this->DoRemove (std::next (this->begin (), n));
+  }
+};
+
+namespace ns3 {
+
+/// \return the type parameter name of RemoveTestQueue storing items in a RingBuffer
+template <>
+std::string
+DoGetTypeParamName<RemoveTestQueue<RingBuffer<Ptr<Packet> > > > ()
+{
+  return "RingBuffer";
+}
+
+/// \return the type parameter name of RemoveTestQueue storing items in a list
+template <>
+std::string
+DoGetTypeParamName<RemoveTestQueue<std::list<Ptr<Packet> > > > ()
+{
+  return "List";
+}
+
+} // namespace ns3
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * Check that removing items other than the head of the queue (DoRemove of
+ * a non-head item, which moves items within a ring buffer) gives the same
+ * result as with a queue storing its items in a list.
+ */
+class QueueRemoveTestCase : public TestCase
+{
+public:
+  QueueRemoveTestCase ();
+  virtual void DoRun (void);
+
+private:
+  /**
+   * Enqueue, dequeue and remove packets from the given queue and record
+   * the sizes of the packets and the statistics of the queue.
+   * \param queue the queue
+   * \return the recorded values
+   */
+  template <typename Container>
+  std::vector<uint32_t> Run (Ptr<RemoveTestQueue<Container> > queue);
+};
+
+QueueRemoveTestCase::QueueRemoveTestCase ()
+  : TestCase ("Check that removing non-head items from a ring buffer queue behaves as with a list")
+{
+}
+
+template <typename Container>
+std::vector<uint32_t>
+QueueRemoveTestCase::Run (Ptr<RemoveTestQueue<Container> > queue)
+{
+  std::vector<uint32_t> record;
+  queue->SetMaxSize (QueueSize ("100p"));
+
+  // move the head of the queue away from the first slot of the buffer
+  for (uint32_t i = 1; i <= 10; i++)
+    {
+      queue->Enqueue (Create<Packet> (i));
+    }
+  for (uint32_t i = 0; i < 3; i++)
+    {
+      record.push_back (queue->Dequeue ()->GetSize ());
+    }
+  // make the buffer grow while it is wrapped around
+  for (uint32_t i = 11; i <= 22; i++)
+    {
+      queue->Enqueue (Create<Packet> (i));
+    }
+
+  // remove an item close to the head, close to the tail and in the middle
+  record.push_back (queue->RemoveAt (1)->GetSize ());
+  record.push_back (queue->RemoveAt (queue->GetNPackets () - 2)->GetSize ());
+  record.push_back (queue->RemoveAt (queue->GetNPackets () / 2)->GetSize ());
+
+  record.push_back (queue->GetNPackets ());
+  record.push_back (queue->GetNBytes ());
+  record.push_back (queue->GetTotalDroppedPackets ());
+  record.push_back (queue->GetTotalDroppedBytes ());
+  record.push_back (queue->Peek ()->GetSize ());
+
+  while (!queue->IsEmpty ())
+    {
+      record.push_back (queue->Dequeue ()->GetSize ());
+    }
+  return record;
+}
+
+void
+QueueRemoveTestCase::DoRun (void)
+{
+  std::vector<uint32_t> ring = Run (CreateObject<RemoveTestQueue<RingBuffer<Ptr<Packet> > > > ());
+  std::vector<uint32_t> list = Run (CreateObject<RemoveTestQueue<std::list<Ptr<Packet> > > > ());
+
+  NS_TEST_ASSERT_MSG_EQ (ring.size (), list.size (), "Queues must hold the same number of packets");
+  for (uint32_t i = 0; i < ring.size (); i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (ring[i], list[i], "Queues behave differently at step " << i);
+    }
+
+  // dequeued 1, 2, 3, then removed 5, 21 and 13 from 4, 5, ..., 22
+  NS_TEST_EXPECT_MSG_EQ (ring[3], 5, "Unexpected item removed close to the head");
+  NS_TEST_EXPECT_MSG_EQ (ring[4], 21, "Unexpected item removed close to the tail");
+  NS_TEST_EXPECT_MSG_EQ (ring[5], 13, "Unexpected item removed in the middle");
+  NS_TEST_EXPECT_MSG_EQ (ring[6], 16, "Unexpected number of packets left");
+  NS_TEST_EXPECT_MSG_EQ (ring[8], 3, "Removed packets must be counted as dropped");
+  NS_TEST_EXPECT_MSG_EQ (ring[10], 4, "Unexpected head of the queue");
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * Check that insertions and removals close to the front and close to the
+ * back of a RingBuffer preserve the order of the items.
+ */
+class RingBufferTestCase : public TestCase
+{
+public:
+  RingBufferTestCase ();
+  virtual void DoRun (void);
+};
+
+RingBufferTestCase::RingBufferTestCase ()
+  : TestCase ("Sanity check on the ring buffer container")
+{
+}
+
+void
+RingBufferTestCase::DoRun (void)
+{
+  RingBuffer<int> buffer;
+  for (int i = 0; i < 20; i++)
+    {
+      buffer.push_back (2 * i);
+    }
+  buffer.pop_front ();
+  buffer.pop_front ();
+  NS_TEST_EXPECT_MSG_EQ (buffer.capacity (), 32, "Buffer must have grown to 32 slots");
+
+  // insert odd numbers close to the front and close to the back
+  auto it = buffer.insert (std::next (buffer.begin ()), 5);
+  NS_TEST_EXPECT_MSG_EQ (*it, 5, "Iterator must point to the inserted item");
+  buffer.insert (std::prev (buffer.end ()), 37);
+  // remove an item close to the front and an item close to the back
+  it = buffer.erase (std::next (buffer.begin (), 2));
+  NS_TEST_EXPECT_MSG_EQ (*it, 8, "Iterator must point to the item following the removed one");
+  it = buffer.erase (std::prev (buffer.end (), 3));
+  NS_TEST_EXPECT_MSG_EQ (*it, 37, "Iterator must point to the item following the removed one");
+
+  int expected[] = {4, 5, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30, 32, 34, 37, 38};
+  NS_TEST_ASSERT_MSG_EQ (buffer.size (), sizeof (expected) / sizeof (int), "Unexpected buffer size");
+  uint32_t i = 0;
+  for (auto item : buffer)
+    {
+      NS_TEST_EXPECT_MSG_EQ (item, expected[i++], "Unexpected item");
+    }
+
+  // erase while browsing, using the iterator returned by erase
+  for (it = buffer.begin (); it != buffer.end (); )
+    {
+      if (*it % 4 == 0)
+        {
+          it = buffer.erase (it);
+        }
+      else
+        {
+          ++it;
+        }
+    }
+  int odd[] = {5, 10, 14, 18, 22, 26, 30, 34, 37, 38};
+  NS_TEST_ASSERT_MSG_EQ (buffer.size (), sizeof (odd) / sizeof (int), "Unexpected buffer size");
+  i = 0;
+  for (auto item : buffer)
+    {
+      NS_TEST_EXPECT_MSG_EQ (item, odd[i++], "Unexpected item");
+    }
+}
+
 /**
  * \ingroup network-test
  * \ingroup tests
@@ -96,6 +383,9 @@ public:
     : TestSuite ("drop-tail-queue", UNIT)
   {
     AddTestCase (new DropTailQueueTestCase (), TestCase::QUICK);
+    AddTestCase (new DropTailQueueFifoTestCase (), TestCase::QUICK);
+    AddTestCase (new QueueRemoveTestCase (), TestCase::QUICK);
+    AddTestCase (new RingBufferTestCase (), TestCase::QUICK);
   }
 };
 
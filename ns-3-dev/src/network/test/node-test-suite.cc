@@ -0,0 +1,197 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/node.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/mac48-address.h"
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Protocol handler dispatch Test Case
+ *
+ * Checks that a received packet is delivered to the handlers matching its
+ * device and protocol, in registration order, and that registering or
+ * unregistering handlers (even while a packet is dispatched) is taken into
+ * account.
+ */
+class NodeProtocolHandlerTestCase : public TestCase
+{
+public:
+  NodeProtocolHandlerTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Deliver a packet to the node through a device.
+   * \param device the receiving device
+   * \param protocol the protocol of the packet
+   * \param to the destination address of the packet
+   * \return the names of the handlers which received the packet, in order
+   */
+  std::string Receive (Ptr<SimpleNetDevice> device, uint16_t protocol, Mac48Address to);
+
+  /// Handler A
+  void HandlerA (Ptr<NetDevice>, Ptr<const Packet>, uint16_t, const Address &,
+                 const Address &, NetDevice::PacketType);
+  /// Handler B
+  void HandlerB (Ptr<NetDevice>, Ptr<const Packet>, uint16_t, const Address &,
+                 const Address &, NetDevice::PacketType);
+  /// Handler C
+  void HandlerC (Ptr<NetDevice>, Ptr<const Packet>, uint16_t, const Address &,
+                 const Address &, NetDevice::PacketType);
+  /// Handler D, which unregisters itself
+  void HandlerD (Ptr<NetDevice>, Ptr<const Packet>, uint16_t, const Address &,
+                 const Address &, NetDevice::PacketType);
+  /// Promiscuous handler
+  void HandlerP (Ptr<NetDevice>, Ptr<const Packet>, uint16_t, const Address &,
+                 const Address &, NetDevice::PacketType);
+
+  Ptr<Node> m_node;   //!< the node
+  std::string m_log;  //!< the handlers which received the last packet
+};
+
+NodeProtocolHandlerTestCase::NodeProtocolHandlerTestCase ()
+  : TestCase ("Dispatch of received packets to protocol handlers")
+{
+}
+
+void
+NodeProtocolHandlerTestCase::HandlerA (Ptr<NetDevice>, Ptr<const Packet>, uint16_t, const Address &,
+                                       const Address &, NetDevice::PacketType)
+{
+  m_log += "A";
+}
+
+void
+NodeProtocolHandlerTestCase::HandlerB (Ptr<NetDevice>, Ptr<const Packet>, uint16_t, const Address &,
+                                       const Address &, NetDevice::PacketType)
+{
+  m_log += "B";
+}
+
+void
+NodeProtocolHandlerTestCase::HandlerC (Ptr<NetDevice>, Ptr<const Packet>, uint16_t, const Address &,
+                                       const Address &, NetDevice::PacketType)
+{
+  m_log += "C";
+}
+
+void
+NodeProtocolHandlerTestCase::HandlerD (Ptr<NetDevice>, Ptr<const Packet>, uint16_t, const Address &,
+                                       const Address &, NetDevice::PacketType)
+{
+  m_log += "D";
+  m_node->UnregisterProtocolHandler (MakeCallback (&NodeProtocolHandlerTestCase::HandlerD, this));
+}
+
+void
+NodeProtocolHandlerTestCase::HandlerP (Ptr<NetDevice>, Ptr<const Packet>, uint16_t, const Address &,
+                                       const Address &, NetDevice::PacketType)
+{
+  m_log += "P";
+}
+
+std::string
+NodeProtocolHandlerTestCase::Receive (Ptr<SimpleNetDevice> device, uint16_t protocol, Mac48Address to)
+{
+  m_log = "";
+  Simulator::ScheduleWithContext (m_node->GetId (), Seconds (0), &SimpleNetDevice::Receive, device,
+                                  Create<Packet> (100), protocol, to, Mac48Address::Allocate ());
+  Simulator::Run ();
+  return m_log;
+}
+
+void
+NodeProtocolHandlerTestCase::DoRun (void)
+{
+  m_node = CreateObject<Node> ();
+  Ptr<SimpleNetDevice> dev0 = CreateObject<SimpleNetDevice> ();
+  dev0->SetAddress (Mac48Address::Allocate ());
+  m_node->AddDevice (dev0);
+  Ptr<SimpleNetDevice> dev1 = CreateObject<SimpleNetDevice> ();
+  dev1->SetAddress (Mac48Address::Allocate ());
+  m_node->AddDevice (dev1);
+  Mac48Address addr0 = Mac48Address::ConvertFrom (dev0->GetAddress ());
+  Mac48Address addr1 = Mac48Address::ConvertFrom (dev1->GetAddress ());
+
+  m_node->RegisterProtocolHandler (MakeCallback (&NodeProtocolHandlerTestCase::HandlerA, this),
+                                   0x0800, dev0);
+  m_node->RegisterProtocolHandler (MakeCallback (&NodeProtocolHandlerTestCase::HandlerB, this),
+                                   0, 0);
+  m_node->RegisterProtocolHandler (MakeCallback (&NodeProtocolHandlerTestCase::HandlerC, this),
+                                   0x0800, 0);
+  m_node->RegisterProtocolHandler (MakeCallback (&NodeProtocolHandlerTestCase::HandlerP, this),
+                                   0, 0, true);
+
+  // non-promiscuous handlers first (in registration order), then promiscuous ones
+  NS_TEST_EXPECT_MSG_EQ (Receive (dev0, 0x0800, addr0), "ABCP", "Wrong handlers for device 0, IPv4");
+  NS_TEST_EXPECT_MSG_EQ (Receive (dev1, 0x0800, addr1), "BCP", "Wrong handlers for device 1, IPv4");
+  NS_TEST_EXPECT_MSG_EQ (Receive (dev1, 0x0806, addr1), "BP", "Wrong handlers for device 1, ARP");
+  // the same lookups again, now served by the dispatch table
+  NS_TEST_EXPECT_MSG_EQ (Receive (dev0, 0x0800, addr0), "ABCP", "Wrong handlers for device 0, IPv4");
+  NS_TEST_EXPECT_MSG_EQ (Receive (dev1, 0x0806, addr1), "BP", "Wrong handlers for device 1, ARP");
+  // packets for another host only reach the promiscuous handlers
+  NS_TEST_EXPECT_MSG_EQ (Receive (dev0, 0x0800, Mac48Address::Allocate ()), "P",
+                         "Wrong handlers for a packet to another host");
+
+  m_node->UnregisterProtocolHandler (MakeCallback (&NodeProtocolHandlerTestCase::HandlerB, this));
+  NS_TEST_EXPECT_MSG_EQ (Receive (dev0, 0x0800, addr0), "ACP", "Unregistered handler still called");
+  NS_TEST_EXPECT_MSG_EQ (Receive (dev1, 0x0806, addr1), "P", "Unregistered handler still called");
+
+  // a handler registered again is called after the older ones
+  m_node->RegisterProtocolHandler (MakeCallback (&NodeProtocolHandlerTestCase::HandlerB, this),
+                                   0x0800, dev0);
+  NS_TEST_EXPECT_MSG_EQ (Receive (dev0, 0x0800, addr0), "ACBP", "Wrong handlers after registration");
+  NS_TEST_EXPECT_MSG_EQ (Receive (dev1, 0x0800, addr1), "CP", "Wrong handlers after registration");
+
+  // a handler unregistering itself while the packet is dispatched
+  m_node->RegisterProtocolHandler (MakeCallback (&NodeProtocolHandlerTestCase::HandlerD, this),
+                                   0, dev0);
+  NS_TEST_EXPECT_MSG_EQ (Receive (dev0, 0x0800, addr0), "ACBDP", "Wrong handlers with handler D");
+  NS_TEST_EXPECT_MSG_EQ (Receive (dev0, 0x0800, addr0), "ACBP", "Handler D not unregistered");
+
+  m_node->UnregisterProtocolHandler (MakeCallback (&NodeProtocolHandlerTestCase::HandlerP, this));
+  NS_TEST_EXPECT_MSG_EQ (Receive (dev0, 0x0800, addr0), "ACB", "Promiscuous handler still called");
+
+  Simulator::Destroy ();
+  m_node = 0;
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Node TestSuite
+ */
+class NodeTestSuite : public TestSuite
+{
+public:
+  NodeTestSuite ()
+    : TestSuite ("node", UNIT)
+  {
+    AddTestCase (new NodeProtocolHandlerTestCase (), TestCase::QUICK);
+  }
+};
+
+static NodeTestSuite g_nodeTestSuite; //!< Static variable for test initialization
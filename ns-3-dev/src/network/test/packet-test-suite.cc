@@ -1150,6 +1150,61 @@ PacketTagListTest::DoRun (void)
 
 }
 
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Packet memory pool test
+ *
+ * Checks that the memory of deleted packets is reused by the next packets
+ * and that a packet created in recycled memory starts from a clean state.
+ */
+class PacketFreeListTest : public TestCase
+{
+public:
+  PacketFreeListTest ();
+  virtual void DoRun (void);
+};
+
+PacketFreeListTest::PacketFreeListTest ()
+  : TestCase ("Packet memory pool")
+{
+}
+
+void
+PacketFreeListTest::DoRun (void)
+{
+  std::vector<Ptr<Packet> > packets;
+  for (uint32_t i = 0; i < 1000; i++)
+    {
+      Ptr<Packet> p = Create<Packet> (i);
+      p->AddPacketTag (ATestTag<1> ());
+      p->AddByteTag (ATestTag<2> ());
+      packets.push_back (p);
+      packets.push_back (p->Copy ());
+    }
+  Packet *last = PeekPointer (packets.back ());
+  uint64_t lastUid = packets.back ()->GetUid ();
+  packets.pop_back ();
+
+  Ptr<Packet> p = Create<Packet> (10);
+#ifdef PACKET_FREE_LIST
+  NS_TEST_EXPECT_MSG_EQ (PeekPointer (p), last, "The memory of the last deleted packet is not reused");
+#endif
+  NS_TEST_EXPECT_MSG_GT (p->GetUid (), lastUid, "A recycled packet must get a new uid");
+  NS_TEST_EXPECT_MSG_EQ (p->GetSize (), 10, "Wrong size of a recycled packet");
+  ATestTag<1> tag;
+  NS_TEST_EXPECT_MSG_EQ (p->PeekPacketTag (tag), false, "A recycled packet must not have packet tags");
+  NS_TEST_EXPECT_MSG_EQ (p->GetByteTagIterator ().HasNext (), false, "A recycled packet must not have byte tags");
+
+  // the packets which were not deleted are left untouched
+  for (uint32_t i = 0; i < packets.size (); i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (packets[i]->GetSize (), i / 2, "Wrong size of packet " << i);
+      NS_TEST_EXPECT_MSG_EQ (packets[i]->PeekPacketTag (tag), true, "Missing packet tag on packet " << i);
+    }
+}
+
 /**
  * \ingroup network-test
  * \ingroup tests
@@ -1167,6 +1222,7 @@ PacketTestSuite::PacketTestSuite ()
 {
   AddTestCase (new PacketTest, TestCase::QUICK);
   AddTestCase (new PacketTagListTest, TestCase::QUICK);
+  AddTestCase (new PacketFreeListTest, TestCase::QUICK);
 }
 
 static PacketTestSuite g_packetTestSuite; //!< Static variable for test initialization
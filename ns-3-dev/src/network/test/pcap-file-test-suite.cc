@@ -21,10 +21,14 @@
 #include <cstdlib>
 #include <sstream>
 #include <cstring>
+#include <fstream>
+#include <iterator>
+#include <vector>
 
 #include "ns3/log.h"
 #include "ns3/test.h"
 #include "ns3/pcap-file.h"
+#include "ns3/pcap-file-mapping.h"
 
 using namespace ns3;
 
@@ -1144,6 +1148,157 @@ DiffTestCase::DoRun (void)
   NS_TEST_EXPECT_MSG_EQ (usec, 3696, "Files are different from 2.3696 seconds");
 }
 
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Test case to make sure that PcapFileMapping reads the same records
+ * as PcapFile and that PcapFile::Diff handles files that are equivalent but
+ * not byte-identical, as well as files that differ after an identical prefix.
+ */
+class MappingTestCase : public TestCase
+{
+public:
+  MappingTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+MappingTestCase::MappingTestCase ()
+  : TestCase ("Check that PcapFileMapping reads the same records as PcapFile")
+{
+}
+
+void
+MappingTestCase::DoRun (void)
+{
+  //
+  // Write a reference trace holding packets with the timestamps and lengths
+  // of the known packets and a distinct content for each packet.
+  //
+  std::string filename = CreateTempDirFilename ("mapping.pcap");
+  uint8_t data[2048];
+  PcapFile out;
+  out.Open (filename, std::ios::out);
+  NS_TEST_ASSERT_MSG_EQ (out.Fail (), false, "Open (" << filename << ", \"std::ios::out\") returns error");
+  out.Init (1, PcapFile::SNAPLEN_DEFAULT, 0, false);
+  for (uint32_t i = 0; i < N_KNOWN_PACKETS; ++i)
+    {
+      PacketEntry const & p = knownPackets[i];
+      for (uint32_t j = 0; j < p.inclLen; ++j)
+        {
+          data[j] = static_cast<uint8_t> (i * 31 + j);
+        }
+      out.Write (p.tsSec, p.tsUsec, data, p.inclLen);
+    }
+  out.Close ();
+
+  PcapFileMapping m;
+  NS_TEST_ASSERT_MSG_EQ (m.Open (filename), true, "Open (" << filename << ") returns error");
+  NS_TEST_ASSERT_MSG_EQ (m.Fail (), false, "Open (" << filename << ") sets the fail state");
+
+  PcapFile f;
+  f.Open (filename, std::ios::in);
+  NS_TEST_ASSERT_MSG_EQ (f.Fail (), false, "Open (" << filename << ", \"std::ios::in\") returns error");
+  NS_TEST_EXPECT_MSG_EQ (m.GetSwapMode (), f.GetSwapMode (), "Swap mode differs from PcapFile");
+  NS_TEST_EXPECT_MSG_EQ (m.GetSnapLen (), f.GetSnapLen (), "Snap length differs from PcapFile");
+  NS_TEST_EXPECT_MSG_EQ (m.GetDataLinkType (), f.GetDataLinkType (), "Data link type differs from PcapFile");
+
+  uint32_t tsSec, tsUsec, inclLen, origLen, readLen;
+  PcapFileMapping::Record record;
+
+  for (uint32_t i = 0; i < N_KNOWN_PACKETS; ++i)
+    {
+      PacketEntry const & p = knownPackets[i];
+
+      NS_TEST_ASSERT_MSG_EQ (m.Read (record), true, "Read() of reference pcap file returns error");
+      NS_TEST_ASSERT_MSG_EQ (record.tsSec, p.tsSec, "Incorrectly read seconds timestap from reference pcap file");
+      NS_TEST_ASSERT_MSG_EQ (record.tsUsec, p.tsUsec, "Incorrectly read microseconds timestap from reference pcap file");
+      NS_TEST_ASSERT_MSG_EQ (record.inclLen, p.inclLen, "Incorrectly read included length from reference packet");
+      NS_TEST_ASSERT_MSG_EQ (record.origLen, p.inclLen, "Incorrectly read original length from reference packet");
+
+      f.Read (data, sizeof(data), tsSec, tsUsec, inclLen, origLen, readLen);
+      NS_TEST_ASSERT_MSG_EQ (readLen, record.inclLen, "PcapFile and PcapFileMapping disagree on the packet length");
+      NS_TEST_ASSERT_MSG_EQ (std::memcmp (data, record.data, readLen), 0, "PcapFile and PcapFileMapping disagree on the packet data");
+    }
+
+  NS_TEST_EXPECT_MSG_EQ (m.Read (record), false, "Read() of reference pcap file at EOF does not return error");
+  m.Rewind ();
+  NS_TEST_EXPECT_MSG_EQ (m.Read (record), true, "Read() after Rewind() returns error");
+  NS_TEST_EXPECT_MSG_EQ (record.tsUsec, knownPackets[0].tsUsec, "Rewind() does not go back to the first packet");
+  m.Close ();
+  f.Close ();
+
+  //
+  // Rewrite the reference file in the other byte order.  The raw content is
+  // different from the first byte on, but the packets are the same.
+  //
+  std::string swapped = CreateTempDirFilename ("swapped.pcap");
+  PcapFile in;
+  in.Open (filename, std::ios::in);
+  out.Open (swapped, std::ios::out);
+  out.Init (in.GetDataLinkType (), in.GetSnapLen (), in.GetTimeZoneOffset (), true);
+  for (uint32_t i = 0; i < N_KNOWN_PACKETS; ++i)
+    {
+      in.Read (data, sizeof(data), tsSec, tsUsec, inclLen, origLen, readLen);
+      out.Write (tsSec, tsUsec, data, readLen);
+    }
+  in.Close ();
+  out.Close ();
+
+  uint32_t sec (0), usec (0), packets (0);
+  bool diff = PcapFile::Diff (filename, swapped, sec, usec, packets);
+  NS_TEST_EXPECT_MSG_EQ (diff, false, "PcapDiff(file, swapped file) must be false");
+  NS_TEST_EXPECT_MSG_EQ (packets, N_KNOWN_PACKETS, "PcapDiff(file, swapped file) must compare all packets");
+
+  //
+  // A file without packets is different from the reference one
+  //
+  out.Open (swapped, std::ios::out);
+  out.Init (1, PcapFile::SNAPLEN_DEFAULT, 0, true);
+  out.Close ();
+  packets = 0;
+  diff = PcapFile::Diff (filename, swapped, sec, usec, packets);
+  NS_TEST_EXPECT_MSG_EQ (diff, true, "PcapDiff(file, empty file) must be true");
+  NS_TEST_EXPECT_MSG_EQ (packets, 0, "PcapDiff(file, empty file) must stop at the first packet");
+
+  //
+  // Copy the reference file byte for byte and flip one byte in the data of
+  // packet k.  All the records before packet k lie in the identical prefix
+  // and are skipped by Diff, which must still count them and report the
+  // timestamp of packet k.
+  //
+  const uint32_t k = N_KNOWN_PACKETS - 2;
+  std::ifstream src (filename.c_str (), std::ios::in | std::ios::binary);
+  std::vector<char> bytes ((std::istreambuf_iterator<char> (src)), std::istreambuf_iterator<char> ());
+  src.close ();
+
+  NS_TEST_ASSERT_MSG_EQ (m.Open (filename), true, "Open (" << filename << ") returns error");
+  for (uint32_t i = 0; i <= k; ++i)
+    {
+      NS_TEST_ASSERT_MSG_EQ (m.Read (record), true, "Read() of reference pcap file returns error");
+    }
+  NS_TEST_ASSERT_MSG_GT (record.inclLen, 0, "Packet " << k << " of the reference file has no data");
+  uint64_t flip = record.offset + PcapFileMapping::RECORD_HEADER_SIZE + record.inclLen / 2;
+  m.Close ();
+  bytes[flip] ^= 0x01;
+
+  std::string modified = CreateTempDirFilename ("modified.pcap");
+  std::ofstream dst (modified.c_str (), std::ios::out | std::ios::binary);
+  dst.write (bytes.data (), bytes.size ());
+  dst.close ();
+
+  sec = 0;
+  usec = 0;
+  packets = 0;
+  diff = PcapFile::Diff (filename, modified, sec, usec, packets);
+  NS_TEST_EXPECT_MSG_EQ (diff, true, "PcapDiff(file, modified file) must be true");
+  NS_TEST_EXPECT_MSG_EQ (packets, k + 1, "PcapDiff(file, modified file) must stop at the modified packet");
+  NS_TEST_EXPECT_MSG_EQ (sec, knownPackets[k].tsSec, "PcapDiff(file, modified file) reports a wrong seconds timestamp");
+  NS_TEST_EXPECT_MSG_EQ (usec, knownPackets[k].tsUsec, "PcapDiff(file, modified file) reports a wrong microseconds timestamp");
+}
+
 /**
  * \ingroup network-test
  * \ingroup tests
@@ -1167,6 +1322,7 @@ PcapFileTestSuite::PcapFileTestSuite ()
   AddTestCase (new RecordHeaderTestCase, TestCase::QUICK);
   AddTestCase (new ReadFileTestCase, TestCase::QUICK);
   AddTestCase (new DiffTestCase, TestCase::QUICK);
+  AddTestCase (new MappingTestCase, TestCase::QUICK);
 }
 
 static PcapFileTestSuite pcapFileTestSuite; //!< Static variable for test initialization
@@ -27,9 +27,12 @@ namespace ns3 {
  * \ingroup queue
  *
  * \brief A FIFO packet queue that drops tail-end packets on overflow
+ *
+ * The Container template parameter selects the container storing the items
+ * (see Queue).
  */
-template <typename Item>
-class DropTailQueue : public Queue<Item>
+template <typename Item, typename Container = RingBuffer<Ptr<Item> > >
+class DropTailQueue : public Queue<Item, Container>
 {
 public:
   /**
@@ -52,12 +55,12 @@ public:
   virtual Ptr<const Item> Peek (void) const;
 
 private:
-  using Queue<Item>::begin;
-  using Queue<Item>::end;
-  using Queue<Item>::DoEnqueue;
-  using Queue<Item>::DoDequeue;
-  using Queue<Item>::DoRemove;
-  using Queue<Item>::DoPeek;
+  using Queue<Item, Container>::begin;
+  using Queue<Item, Container>::end;
+  using Queue<Item, Container>::DoEnqueue;
+  using Queue<Item, Container>::DoDequeue;
+  using Queue<Item, Container>::DoRemove;
+  using Queue<Item, Container>::DoPeek;
 
   NS_LOG_TEMPLATE_DECLARE;     //!< redefinition of the log component
 };
@@ -67,14 +70,14 @@ private:
  * Implementation of the templates declared above.
  */
 
-template <typename Item>
+template <typename Item, typename Container>
 TypeId
-DropTailQueue<Item>::GetTypeId (void)
+DropTailQueue<Item, Container>::GetTypeId (void)
 {
-  static TypeId tid = TypeId ("ns3::DropTailQueue<" + GetTypeParamName<DropTailQueue<Item> > () + ">")
-    .SetParent<Queue<Item> > ()
+  static TypeId tid = TypeId ("ns3::DropTailQueue<" + GetTypeParamName<DropTailQueue<Item, Container> > () + ">")
+    .SetParent<Queue<Item, Container> > ()
     .SetGroupName ("Network")
-    .template AddConstructor<DropTailQueue<Item> > ()
+    .template AddConstructor<DropTailQueue<Item, Container> > ()
     .AddAttribute ("MaxSize",
                    "The max queue size",
                    QueueSizeValue (QueueSize ("100p")),
@@ -85,32 +88,32 @@ DropTailQueue<Item>::GetTypeId (void)
   return tid;
 }
 
-template <typename Item>
-DropTailQueue<Item>::DropTailQueue () :
-  Queue<Item> (),
+template <typename Item, typename Container>
+DropTailQueue<Item, Container>::DropTailQueue () :
+  Queue<Item, Container> (),
   NS_LOG_TEMPLATE_DEFINE ("DropTailQueue")
 {
   NS_LOG_FUNCTION (this);
 }
 
-template <typename Item>
-DropTailQueue<Item>::~DropTailQueue ()
+template <typename Item, typename Container>
+DropTailQueue<Item, Container>::~DropTailQueue ()
 {
   NS_LOG_FUNCTION (this);
 }
 
-template <typename Item>
+template <typename Item, typename Container>
 bool
-DropTailQueue<Item>::Enqueue (Ptr<Item> item)
+DropTailQueue<Item, Container>::Enqueue (Ptr<Item> item)
 {
   NS_LOG_FUNCTION (this << item);
 
   return DoEnqueue (end (), item);
 }
 
-template <typename Item>
+template <typename Item, typename Container>
 Ptr<Item>
-DropTailQueue<Item>::Dequeue (void)
+DropTailQueue<Item, Container>::Dequeue (void)
 {
   NS_LOG_FUNCTION (this);
 
@@ -121,9 +124,9 @@ DropTailQueue<Item>::Dequeue (void)
   return item;
 }
 
-template <typename Item>
+template <typename Item, typename Container>
 Ptr<Item>
-DropTailQueue<Item>::Remove (void)
+DropTailQueue<Item, Container>::Remove (void)
 {
   NS_LOG_FUNCTION (this);
 
@@ -134,9 +137,9 @@ DropTailQueue<Item>::Remove (void)
   return item;
 }
 
-template <typename Item>
+template <typename Item, typename Container>
 Ptr<const Item>
-DropTailQueue<Item>::Peek (void) const
+DropTailQueue<Item, Container>::Peek (void) const
 {
   NS_LOG_FUNCTION (this);
 
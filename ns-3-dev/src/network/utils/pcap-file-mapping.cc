@@ -0,0 +1,267 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include "pcap-file-mapping.h"
+#include "pcap-file.h"
+#include "ns3/log.h"
+
+#if !defined (__win32__)
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+//
+// This file is used as part of the ns-3 test framework, so please refrain from
+// adding any ns-3 specific constructs such as Packet to this file.
+//
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("PcapFileMapping");
+
+PcapFileMapping::PcapFileMapping ()
+  : m_data (0),
+    m_size (0),
+    m_offset (0),
+    m_mapping (0),
+    m_fail (true),
+    m_swapMode (false),
+    m_nanosecMode (false),
+    m_snapLen (0),
+    m_type (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+PcapFileMapping::~PcapFileMapping ()
+{
+  NS_LOG_FUNCTION (this);
+  Close ();
+}
+
+bool
+PcapFileMapping::Open (std::string const &filename)
+{
+  NS_LOG_FUNCTION (this << filename);
+  Close ();
+
+#if !defined (__win32__)
+  int fd = open (filename.c_str (), O_RDONLY);
+  if (fd < 0)
+    {
+      NS_LOG_LOGIC ("Cannot open " << filename);
+      return false;
+    }
+  struct stat st;
+  if (fstat (fd, &st) == 0 && st.st_size > 0)
+    {
+      void *addr = mmap (0, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (addr != MAP_FAILED)
+        {
+          //
+          // Records are almost always walked front to back, so tell the
+          // kernel to read ahead aggressively.
+          //
+          madvise (addr, st.st_size, MADV_SEQUENTIAL);
+          m_mapping = addr;
+          m_data = static_cast<uint8_t const *> (addr);
+          m_size = st.st_size;
+        }
+    }
+  close (fd);
+#endif
+
+  if (m_mapping == 0)
+    {
+      //
+      // Either mmap() is not available or it failed (e.g., the file is not a
+      // regular file).  Fall back to reading the content in one go.
+      //
+      std::ifstream file (filename.c_str (), std::ios::in | std::ios::binary);
+      if (!file)
+        {
+          NS_LOG_LOGIC ("Cannot open " << filename);
+          return false;
+        }
+      m_copy.assign (std::istreambuf_iterator<char> (file), std::istreambuf_iterator<char> ());
+      m_data = m_copy.data ();
+      m_size = m_copy.size ();
+    }
+
+  m_fail = !VerifyFileHeader ();
+  m_offset = FILE_HEADER_SIZE;
+  if (m_fail)
+    {
+      Close ();
+    }
+  return !m_fail;
+}
+
+void
+PcapFileMapping::Close (void)
+{
+  NS_LOG_FUNCTION (this);
+#if !defined (__win32__)
+  if (m_mapping != 0)
+    {
+      munmap (m_mapping, m_size);
+    }
+#endif
+  m_mapping = 0;
+  m_copy.clear ();
+  m_copy.shrink_to_fit ();
+  m_data = 0;
+  m_size = 0;
+  m_offset = 0;
+  m_fail = true;
+}
+
+bool
+PcapFileMapping::Fail (void) const
+{
+  return m_fail;
+}
+
+uint32_t
+PcapFileMapping::ReadU32 (uint64_t offset) const
+{
+  uint32_t val;
+  std::memcpy (&val, m_data + offset, sizeof (val));
+  if (m_swapMode)
+    {
+      val = ((val >> 24) & 0x000000ff) | ((val >> 8) & 0x0000ff00) | ((val << 8) & 0x00ff0000) | ((val << 24) & 0xff000000);
+    }
+  return val;
+}
+
+uint16_t
+PcapFileMapping::ReadU16 (uint64_t offset) const
+{
+  uint16_t val;
+  std::memcpy (&val, m_data + offset, sizeof (val));
+  if (m_swapMode)
+    {
+      val = ((val >> 8) & 0x00ff) | ((val << 8) & 0xff00);
+    }
+  return val;
+}
+
+bool
+PcapFileMapping::VerifyFileHeader (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (m_size < FILE_HEADER_SIZE)
+    {
+      return false;
+    }
+
+  //
+  // Validation is shared with PcapFile so that both readers accept the
+  // same files.  The magic number tells whether the remaining fields have
+  // to be swapped by ReadU16/ReadU32.
+  //
+  m_swapMode = false;
+  if (!PcapFile::CheckMagic (ReadU32 (0), m_swapMode, m_nanosecMode))
+    {
+      return false;
+    }
+  if (!PcapFile::CheckVersion (ReadU16 (4), ReadU16 (6), static_cast<int32_t> (ReadU32 (8))))
+    {
+      return false;
+    }
+
+  m_snapLen = ReadU32 (16);
+  m_type = ReadU32 (20);
+  return true;
+}
+
+bool
+PcapFileMapping::Read (Record &record)
+{
+  NS_LOG_FUNCTION (this);
+  if (m_fail || m_size - m_offset < RECORD_HEADER_SIZE)
+    {
+      return false;
+    }
+
+  uint32_t inclLen = ReadU32 (m_offset + 8);
+  if (m_size - m_offset - RECORD_HEADER_SIZE < inclLen)
+    {
+      NS_LOG_LOGIC ("Truncated record at offset " << m_offset);
+      return false;
+    }
+
+  record.tsSec = ReadU32 (m_offset);
+  record.tsUsec = ReadU32 (m_offset + 4);
+  record.inclLen = inclLen;
+  record.origLen = ReadU32 (m_offset + 12);
+  record.data = m_data + m_offset + RECORD_HEADER_SIZE;
+  record.offset = m_offset;
+
+  m_offset += RECORD_HEADER_SIZE + inclLen;
+  return true;
+}
+
+void
+PcapFileMapping::Rewind (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_offset = FILE_HEADER_SIZE;
+}
+
+uint8_t const *
+PcapFileMapping::GetData (void) const
+{
+  return m_data;
+}
+
+uint64_t
+PcapFileMapping::GetSize (void) const
+{
+  return m_size;
+}
+
+bool
+PcapFileMapping::GetSwapMode (void) const
+{
+  return m_swapMode;
+}
+
+bool
+PcapFileMapping::IsNanoSecMode (void) const
+{
+  return m_nanosecMode;
+}
+
+uint32_t
+PcapFileMapping::GetSnapLen (void) const
+{
+  return m_snapLen;
+}
+
+uint32_t
+PcapFileMapping::GetDataLinkType (void) const
+{
+  return m_type;
+}
+
+} // namespace ns3
@@ -0,0 +1,163 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef PCAP_FILE_MAPPING_H
+#define PCAP_FILE_MAPPING_H
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+namespace ns3 {
+
+/**
+ * \brief A read-only, memory-mapped view of a pcap file
+ *
+ * PcapFile reads records through an fstream and copies the packet data
+ * into a caller-supplied buffer.  For large trace files (e.g., when
+ * comparing simulation output against reference traces) this class maps
+ * the whole file into memory instead and hands out records whose data
+ * pointer refers directly to the mapped bytes, so that no copy is made.
+ *
+ * Record views remain valid until the file is closed.  On platforms
+ * without mmap(), or when the mapping fails, the file content is read
+ * into memory once and the same interface is provided on top of it.
+ */
+class PcapFileMapping
+{
+public:
+  /**
+   * \brief A zero-copy view of a pcap record
+   */
+  struct Record
+  {
+    uint32_t tsSec;       //!< seconds part of timestamp
+    uint32_t tsUsec;      //!< microseconds part of timestamp (nsecs for nanosecond files)
+    uint32_t inclLen;     //!< number of octets of packet saved in file
+    uint32_t origLen;     //!< actual length of original packet
+    uint8_t const *data;  //!< packet data, inclLen bytes long
+    uint64_t offset;      //!< offset of the record header from the start of the file
+  };
+
+  PcapFileMapping ();
+  ~PcapFileMapping ();
+
+  /**
+   * Map an existing pcap file and verify its file header.
+   *
+   * \param filename the name of the file
+   * \return true if the file has been mapped and holds a valid pcap header
+   */
+  bool Open (std::string const &filename);
+
+  /**
+   * Release the mapping.  Record views obtained so far become invalid.
+   */
+  void Close (void);
+
+  /**
+   * \return true if the last Open() failed or no file is open
+   */
+  bool Fail (void) const;
+
+  /**
+   * \brief Get the next record of the file
+   *
+   * A truncated trailing record is treated as the end of the file.
+   *
+   * \param record [out] the record view
+   * \return false if there are no more (complete) records
+   */
+  bool Read (Record &record);
+
+  /**
+   * Position the read pointer back on the first record of the file.
+   */
+  void Rewind (void);
+
+  /**
+   * \return the raw bytes of the whole file, including the file header
+   */
+  uint8_t const * GetData (void) const;
+
+  /**
+   * \return the size of the file in bytes
+   */
+  uint64_t GetSize (void) const;
+
+  /**
+   * \return true if the fields of the file are byte-swapped with respect to the host
+   */
+  bool GetSwapMode (void) const;
+
+  /**
+   * \return true if the packet timestamps have nanosecond resolution
+   */
+  bool IsNanoSecMode (void) const;
+
+  /**
+   * \return the max length of saved packets field of the pcap global header
+   */
+  uint32_t GetSnapLen (void) const;
+
+  /**
+   * \return the data link type field of the pcap global header
+   */
+  uint32_t GetDataLinkType (void) const;
+
+  /// Size of the pcap file header, in bytes
+  static const uint32_t FILE_HEADER_SIZE = 24;
+  /// Size of a pcap record header, in bytes
+  static const uint32_t RECORD_HEADER_SIZE = 16;
+
+private:
+  PcapFileMapping (const PcapFileMapping &) = delete;
+  PcapFileMapping & operator = (const PcapFileMapping &) = delete;
+
+  /**
+   * \brief Read a 32 bit field of the file, taking care of alignment and byte order
+   * \param offset the offset of the field from the start of the file
+   * \returns the host order value
+   */
+  uint32_t ReadU32 (uint64_t offset) const;
+  /**
+   * \brief Read a 16 bit field of the file, taking care of alignment and byte order
+   * \param offset the offset of the field from the start of the file
+   * \returns the host order value
+   */
+  uint16_t ReadU16 (uint64_t offset) const;
+
+  /**
+   * \brief Verify the pcap file header
+   * \return true if the header is valid
+   */
+  bool VerifyFileHeader (void);
+
+  uint8_t const *m_data;        //!< start of the file content
+  uint64_t m_size;              //!< size of the file content
+  uint64_t m_offset;            //!< offset of the next record to read
+  void *m_mapping;              //!< address returned by mmap, or 0
+  std::vector<uint8_t> m_copy;  //!< file content when mmap is unavailable
+  bool m_fail;                  //!< true if no valid file is open
+  bool m_swapMode;              //!< swap mode
+  bool m_nanosecMode;           //!< nanosecond timestamp mode
+  uint32_t m_snapLen;           //!< snap length of the file
+  uint32_t m_type;              //!< data link type of the file
+};
+
+} // namespace ns3
+
+#endif /* PCAP_FILE_MAPPING_H */
@@ -20,6 +20,7 @@
 
 #include <iostream>
 #include <cstring>
+#include <algorithm>
 #include "ns3/assert.h"
 #include "ns3/packet.h"
 #include "ns3/fatal-error.h"
@@ -27,6 +28,7 @@
 #include "ns3/header.h"
 #include "ns3/buffer.h"
 #include "pcap-file.h"
+#include "pcap-file-mapping.h"
 #include "ns3/log.h"
 #include "ns3/build-profile.h"
 //
@@ -38,15 +40,6 @@ namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("PcapFile");
 
-const uint32_t MAGIC = 0xa1b2c3d4;            /**< Magic number identifying standard pcap file format */
-const uint32_t SWAPPED_MAGIC = 0xd4c3b2a1;    /**< Looks this way if byte swapping is required */
-
-const uint32_t NS_MAGIC = 0xa1b23c4d;         /**< Magic number identifying nanosec resolution pcap file format */
-const uint32_t NS_SWAPPED_MAGIC = 0x4d3cb2a1; /**< Looks this way if byte swapping is required */
-
-const uint16_t VERSION_MAJOR = 2;             /**< Major version of supported pcap file format */
-const uint16_t VERSION_MINOR = 4;             /**< Minor version of supported pcap file format */
-
 PcapFile::PcapFile ()
   : m_file (),
     m_swapMode (false),
@@ -243,6 +236,34 @@ PcapFile::WriteFileHeader (void)
   m_file.write ((const char *)&headerOut->m_type, sizeof(headerOut->m_type));
 }
 
+bool
+PcapFile::CheckMagic (uint32_t magic, bool &swapMode, bool &nanosecMode)
+{
+  NS_LOG_FUNCTION (magic);
+  swapMode = (magic == SWAPPED_MAGIC || magic == NS_SWAPPED_MAGIC);
+  nanosecMode = (magic == NS_MAGIC || magic == NS_SWAPPED_MAGIC);
+  return magic == MAGIC || magic == SWAPPED_MAGIC || magic == NS_MAGIC || magic == NS_SWAPPED_MAGIC;
+}
+
+bool
+PcapFile::CheckVersion (uint16_t versionMajor, uint16_t versionMinor, int32_t zone)
+{
+  NS_LOG_FUNCTION (versionMajor << versionMinor << zone);
+  //
+  // We only deal with one version of the pcap file format.
+  //
+  if (versionMajor != VERSION_MAJOR || versionMinor != VERSION_MINOR)
+    {
+      return false;
+    }
+
+  //
+  // A quick test of reasonablness for the time zone offset corresponding to
+  // a real place on the planet.
+  //
+  return zone >= -12 && zone <= 12;
+}
+
 void
 PcapFile::ReadAndVerifyFileHeader (void)
 {
@@ -269,13 +290,7 @@ PcapFile::ReadAndVerifyFileHeader (void)
       return;
     }
 
-  //
-  // There are four possible magic numbers that can be there.  Normal and byte
-  // swapped versions of the standard magic number, and normal and byte swapped
-  // versions of the magic number indicating nanosecond resolution timestamps.
-  //
-  if (m_fileHeader.m_magicNumber != MAGIC && m_fileHeader.m_magicNumber != SWAPPED_MAGIC &&
-      m_fileHeader.m_magicNumber != NS_MAGIC && m_fileHeader.m_magicNumber != NS_SWAPPED_MAGIC)
+  if (!CheckMagic (m_fileHeader.m_magicNumber, m_swapMode, m_nanosecMode))
     {
       m_file.setstate (std::ios::failbit);
     }
@@ -284,33 +299,12 @@ PcapFile::ReadAndVerifyFileHeader (void)
   // If the magic number is swapped, then we can assume that everything else we read
   // is swapped.
   //
-  m_swapMode = (m_fileHeader.m_magicNumber == SWAPPED_MAGIC
-                || m_fileHeader.m_magicNumber == NS_SWAPPED_MAGIC);
-
   if (m_swapMode)
     {
       Swap (&m_fileHeader, &m_fileHeader);
     }
 
-  //
-  // Timestamps can either be microsecond or nanosecond
-  //
-  m_nanosecMode = ((m_fileHeader.m_magicNumber == NS_MAGIC) ||
-                   (m_fileHeader.m_magicNumber == NS_SWAPPED_MAGIC));
-
-  //
-  // We only deal with one version of the pcap file format.
-  //
-  if (m_fileHeader.m_versionMajor != VERSION_MAJOR || m_fileHeader.m_versionMinor != VERSION_MINOR)
-    {
-      m_file.setstate (std::ios::failbit);
-    }
-
-  //
-  // A quick test of reasonablness for the time zone offset corresponding to
-  // a real place on the planet.
-  //
-  if (m_fileHeader.m_zone < -12 || m_fileHeader.m_zone > 12)
+  if (!CheckVersion (m_fileHeader.m_versionMajor, m_fileHeader.m_versionMinor, m_fileHeader.m_zone))
     {
       m_file.setstate (std::ios::failbit);
     }
@@ -524,66 +518,110 @@ PcapFile::Read (
     }
 }
 
+/**
+ * \brief Find the length of the common prefix of two byte ranges
+ * \param a first byte range
+ * \param b second byte range
+ * \param size number of bytes to compare
+ * \returns the offset of the first different byte, or size if none
+ */
+static uint64_t
+CommonPrefixLength (uint8_t const *a, uint8_t const *b, uint64_t size)
+{
+  //
+  // memcmp large blocks and only look at single bytes within the block
+  // where the first difference is.
+  //
+  const uint64_t BLOCK = 64 * 1024;
+  uint64_t offset = 0;
+  while (offset < size)
+    {
+      uint64_t len = std::min (BLOCK, size - offset);
+      if (std::memcmp (a + offset, b + offset, len) != 0)
+        {
+          while (a[offset] == b[offset])
+            {
+              ++offset;
+            }
+          return offset;
+        }
+      offset += len;
+    }
+  return size;
+}
+
 bool
 PcapFile::Diff (std::string const & f1, std::string const & f2,
                 uint32_t & sec, uint32_t & usec, uint32_t & packets,
                 uint32_t snapLen)
 {
   NS_LOG_FUNCTION (f1 << f2 << sec << usec << snapLen);
-  PcapFile pcap1, pcap2;
-  pcap1.Open (f1, std::ios::in);
-  pcap2.Open (f2, std::ios::in);
+  PcapFileMapping pcap1, pcap2;
+  pcap1.Open (f1);
+  pcap2.Open (f2);
   bool bad = pcap1.Fail () || pcap2.Fail ();
   if (bad)
     {
       return true;
     }
 
-  uint8_t *data1 = new uint8_t [snapLen] ();
-  uint8_t *data2 = new uint8_t [snapLen] ();
+  //
+  // The files are usually identical, or identical up to some point.  Find
+  // out where the raw content starts to differ: records that lie entirely
+  // before that point are the same in both files (same offsets, same
+  // byte order) and need no decoding beyond walking the record headers.
+  //
+  uint64_t same = CommonPrefixLength (pcap1.GetData (), pcap2.GetData (),
+                                      std::min (pcap1.GetSize (), pcap2.GetSize ()));
+  NS_LOG_LOGIC ("Files are identical for the first " << same << " bytes");
+
+  PcapFileMapping::Record r1;
+  PcapFileMapping::Record r2;
   uint32_t tsSec1 = 0;
-  uint32_t tsSec2 = 0;
   uint32_t tsUsec1 = 0;
-  uint32_t tsUsec2 = 0;
-  uint32_t inclLen1 = 0;
-  uint32_t inclLen2 = 0;
-  uint32_t origLen1 = 0;
-  uint32_t origLen2 = 0;
-  uint32_t readLen1 = 0;
-  uint32_t readLen2 = 0;
   bool diff = false;
 
-  while (!pcap1.Eof () && !pcap2.Eof ())
+  while (true)
     {
-      pcap1.Read (data1, snapLen, tsSec1, tsUsec1, inclLen1, origLen1, readLen1);
-      pcap2.Read (data2, snapLen, tsSec2, tsUsec2, inclLen2, origLen2, readLen2);
-
-      bool same = pcap1.Fail () == pcap2.Fail ();
-      if (!same)
+      bool ok1 = pcap1.Read (r1);
+      bool ok2 = pcap2.Read (r2);
+      if (ok1)
+        {
+          tsSec1 = r1.tsSec;
+          tsUsec1 = r1.tsUsec;
+        }
+      if (ok1 != ok2)
         {
-          diff = true;
+          diff = true; // One file has more packets than the other
           break;
         }
-      if (pcap1.Eof ())
+      if (!ok1)
         {
           break;
         }
 
       ++packets;
 
-      if (tsSec1 != tsSec2 || tsUsec1 != tsUsec2)
+      if (r1.offset + PcapFileMapping::RECORD_HEADER_SIZE + r1.inclLen <= same)
+        {
+          continue;
+        }
+
+      if (r1.tsSec != r2.tsSec || r1.tsUsec != r2.tsUsec)
         {
           diff = true; // Next packet timestamps do not match
           break;
         }
 
+      uint32_t readLen1 = std::min (snapLen, r1.inclLen);
+      uint32_t readLen2 = std::min (snapLen, r2.inclLen);
       if (readLen1 != readLen2)
         {
           diff = true; // Packet lengths do not match
           break;
         }
 
-      if (std::memcmp (data1, data2, readLen1) != 0)
+      if (std::memcmp (r1.data, r2.data, readLen1) != 0)
         {
           diff = true; // Packet data do not match
           break;
@@ -592,16 +630,6 @@ PcapFile::Diff (std::string const & f1, std::string const & f2,
   sec = tsSec1;
   usec = tsUsec1;
 
-  bad = pcap1.Fail () || pcap2.Fail ();
-  bool eof = pcap1.Eof () && pcap2.Eof ();
-  if (bad && !eof)
-    {
-      diff = true;
-    }
-
-  delete[] data1;
-  delete[] data2;
-
   return diff;
 }
 
@@ -45,6 +45,14 @@ public:
   static const int32_t  ZONE_DEFAULT    = 0;           /**< Time zone offset for current location */
   static const uint32_t SNAPLEN_DEFAULT = 65535;       /**< Default value for maximum octets to save per packet */
 
+  static const uint32_t MAGIC = 0xa1b2c3d4;            /**< Magic number identifying standard pcap file format */
+  static const uint32_t SWAPPED_MAGIC = 0xd4c3b2a1;    /**< Looks this way if byte swapping is required */
+  static const uint32_t NS_MAGIC = 0xa1b23c4d;         /**< Magic number identifying nanosec resolution pcap file format */
+  static const uint32_t NS_SWAPPED_MAGIC = 0x4d3cb2a1; /**< Looks this way if byte swapping is required */
+
+  static const uint16_t VERSION_MAJOR = 2;             /**< Major version of supported pcap file format */
+  static const uint16_t VERSION_MINOR = 4;             /**< Minor version of supported pcap file format */
+
 public:
   PcapFile ();
   ~PcapFile ();
@@ -273,6 +281,10 @@ public:
 
   /**
    * \brief Compare two PCAP files packet-by-packet
+   *
+   * Both files are memory-mapped (see PcapFileMapping).  Records lying in
+   * the byte-identical leading part of the files are only counted; records
+   * are decoded and compared field by field from the first difference on.
    * 
    * \return true if files are different, false otherwise
    * 
@@ -287,6 +299,30 @@ public:
                     uint32_t & sec, uint32_t & usec, uint32_t & packets,
                     uint32_t snapLen = SNAPLEN_DEFAULT);
 
+  /**
+   * \brief Check the magic number of a pcap file header
+   *
+   * There are four possible magic numbers.  Normal and byte swapped versions
+   * of the standard magic number, and normal and byte swapped versions of the
+   * magic number indicating nanosecond resolution timestamps.
+   *
+   * \param magic the magic number, as read from the file
+   * \param swapMode [out] true if the fields of the file are byte swapped
+   * \param nanosecMode [out] true if the timestamps have nanosecond resolution
+   * \return true if the magic number is one of the known ones
+   */
+  static bool CheckMagic (uint32_t magic, bool &swapMode, bool &nanosecMode);
+
+  /**
+   * \brief Check the version and time zone fields of a pcap file header
+   *
+   * \param versionMajor major version, in host byte order
+   * \param versionMinor minor version, in host byte order
+   * \param zone time zone offset, in host byte order
+   * \return true if the file is in a supported format
+   */
+  static bool CheckVersion (uint16_t versionMajor, uint16_t versionMinor, int32_t zone);
+
 private:
   /**
    * \brief Pcap file header
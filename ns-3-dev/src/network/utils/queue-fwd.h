@@ -0,0 +1,40 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef QUEUE_FWD_H
+#define QUEUE_FWD_H
+
+#include "ns3/ptr.h"
+
+namespace ns3 {
+
+template <typename T>
+class RingBuffer;
+
+/**
+ * \ingroup queue
+ * \brief Forward declaration of the Queue class template
+ *
+ * The default argument of the Container template parameter can only be
+ * given once, hence headers that only need to declare Ptr<Queue<Item> >
+ * members include this file rather than repeating the declaration.
+ */
+template <typename Item, typename Container = RingBuffer<Ptr<Item> > >
+class Queue;
+
+} // namespace ns3
+
+#endif /* QUEUE_FWD_H */
@@ -30,6 +30,8 @@
 #include "ns3/log.h"
 #include "ns3/queue-size.h"
 #include "ns3/queue-item.h"
+#include "ns3/ring-buffer.h"
+#include "ns3/queue-fwd.h"
 #include <string>
 #include <sstream>
 #include <list>
@@ -226,7 +228,7 @@ private:
   QueueSize m_maxSize;                //!< max queue size
 
   /// Friend class
-  template <typename Item>
+  template <typename Item, typename Container>
   friend class Queue;
 };
 
@@ -246,18 +248,27 @@ private:
  * methods in doing so, to ensure that appropriate trace sources are called
  * and statistics are maintained.
  *
+ * The items are stored in a container of type Container, which defaults to
+ * RingBuffer<Ptr<Item> >: enqueuing at the tail and dequeuing from the head
+ * do not allocate memory once the buffer has grown to its working size.
+ * Inserting or removing any item invalidates all the iterators of a
+ * RingBuffer, including end (). Subclasses that keep iterators to queued
+ * items across insertions or removals (e.g., to remove items while browsing
+ * the queue) must select a node-based container such as std::list<Ptr<Item> >
+ * through the second template parameter.
+ *
  * Users of the Queue template class usually hold a queue through a smart pointer,
  * hence forward declaration is recommended to avoid pulling the implementation
- * of the templates included in this file. Thus, do not include queue.h but add
- * the following forward declaration in your .h file:
+ * of the templates included in this file. Thus, do not include queue.h but
+ * include queue-fwd.h in your .h file, which declares:
  *
  * \code
- *   template <typename Item> class Queue;
+ *   template <typename Item, typename Container = RingBuffer<Ptr<Item> > > class Queue;
  * \endcode
  *
  * Then, include queue.h in the corresponding .cc file.
  */
-template <typename Item>
+template <typename Item, typename Container>
 class Queue : public QueueBase
 {
 public:
@@ -311,9 +322,9 @@ public:
 protected:
 
   /// Const iterator.
-  typedef typename std::list<Ptr<Item> >::const_iterator ConstIterator;
+  typedef typename Container::const_iterator ConstIterator;
   /// Iterator.
-  typedef typename std::list<Ptr<Item> >::iterator Iterator;
+  typedef typename Container::iterator Iterator;
 
   /**
    * \brief Get a const iterator which refers to the first item in the queue.
@@ -440,7 +451,7 @@ protected:
   void DoDispose (void) override;
 
 private:
-  std::list<Ptr<Item> > m_packets;          //!< the items in the queue
+  Container m_packets;                      //!< the items in the queue
   NS_LOG_TEMPLATE_DECLARE;                  //!< the log component
 
   /// Traced callback: fired when a packet is enqueued
@@ -460,55 +471,55 @@ private:
  * Implementation of the templates declared above.
  */
 
-template <typename Item>
+template <typename Item, typename Container>
 TypeId
-Queue<Item>::GetTypeId (void)
+Queue<Item, Container>::GetTypeId (void)
 {
-  std::string name = GetTypeParamName<Queue<Item> > ();
+  std::string name = GetTypeParamName<Queue<Item, Container> > ();
   static TypeId tid = TypeId ("ns3::Queue<" + name + ">")
     .SetParent<QueueBase> ()
     .SetGroupName ("Network")
     .AddTraceSource ("Enqueue", "Enqueue a packet in the queue.",
-                     MakeTraceSourceAccessor (&Queue<Item>::m_traceEnqueue),
+                     MakeTraceSourceAccessor (&Queue<Item, Container>::m_traceEnqueue),
                      "ns3::" + name + "::TracedCallback")
     .AddTraceSource ("Dequeue", "Dequeue a packet from the queue.",
-                     MakeTraceSourceAccessor (&Queue<Item>::m_traceDequeue),
+                     MakeTraceSourceAccessor (&Queue<Item, Container>::m_traceDequeue),
                      "ns3::" + name + "::TracedCallback")
     .AddTraceSource ("Drop", "Drop a packet (for whatever reason).",
-                     MakeTraceSourceAccessor (&Queue<Item>::m_traceDrop),
+                     MakeTraceSourceAccessor (&Queue<Item, Container>::m_traceDrop),
                      "ns3::" + name + "::TracedCallback")
     .AddTraceSource ("DropBeforeEnqueue", "Drop a packet before enqueue.",
-                     MakeTraceSourceAccessor (&Queue<Item>::m_traceDropBeforeEnqueue),
+                     MakeTraceSourceAccessor (&Queue<Item, Container>::m_traceDropBeforeEnqueue),
                      "ns3::" + name + "::TracedCallback")
     .AddTraceSource ("DropAfterDequeue", "Drop a packet after dequeue.",
-                     MakeTraceSourceAccessor (&Queue<Item>::m_traceDropAfterDequeue),
+                     MakeTraceSourceAccessor (&Queue<Item, Container>::m_traceDropAfterDequeue),
                      "ns3::" + name + "::TracedCallback")
   ;
   return tid;
 }
 
-template <typename Item>
-Queue<Item>::Queue ()
+template <typename Item, typename Container>
+Queue<Item, Container>::Queue ()
   : NS_LOG_TEMPLATE_DEFINE ("Queue")
 {
 }
 
-template <typename Item>
-Queue<Item>::~Queue ()
+template <typename Item, typename Container>
+Queue<Item, Container>::~Queue ()
 {
 }
 
-template <typename Item>
+template <typename Item, typename Container>
 bool
-Queue<Item>::DoEnqueue (ConstIterator pos, Ptr<Item> item)
+Queue<Item, Container>::DoEnqueue (ConstIterator pos, Ptr<Item> item)
 {
   Iterator ret;
   return DoEnqueue (pos, item, ret);
 }
 
-template <typename Item>
+template <typename Item, typename Container>
 bool
-Queue<Item>::DoEnqueue (ConstIterator pos, Ptr<Item> item, Iterator& ret)
+Queue<Item, Container>::DoEnqueue (ConstIterator pos, Ptr<Item> item, Iterator& ret)
 {
   NS_LOG_FUNCTION (this << item);
 
@@ -534,9 +545,9 @@ Queue<Item>::DoEnqueue (ConstIterator pos, Ptr<Item> item, Iterator& ret)
   return true;
 }
 
-template <typename Item>
+template <typename Item, typename Container>
 Ptr<Item>
-Queue<Item>::DoDequeue (ConstIterator pos)
+Queue<Item, Container>::DoDequeue (ConstIterator pos)
 {
   NS_LOG_FUNCTION (this);
 
@@ -563,9 +574,9 @@ Queue<Item>::DoDequeue (ConstIterator pos)
   return item;
 }
 
-template <typename Item>
+template <typename Item, typename Container>
 Ptr<Item>
-Queue<Item>::DoRemove (ConstIterator pos)
+Queue<Item, Container>::DoRemove (ConstIterator pos)
 {
   NS_LOG_FUNCTION (this);
 
@@ -595,9 +606,9 @@ Queue<Item>::DoRemove (ConstIterator pos)
   return item;
 }
 
-template <typename Item>
+template <typename Item, typename Container>
 void
-Queue<Item>::Flush (void)
+Queue<Item, Container>::Flush (void)
 {
   NS_LOG_FUNCTION (this);
   while (!IsEmpty ())
@@ -606,18 +617,18 @@ Queue<Item>::Flush (void)
     }
 }
 
-template <typename Item>
+template <typename Item, typename Container>
 void
-Queue<Item>::DoDispose (void)
+Queue<Item, Container>::DoDispose (void)
 {
   NS_LOG_FUNCTION (this);
   m_packets.clear ();
   Object::DoDispose ();
 }
 
-template <typename Item>
+template <typename Item, typename Container>
 Ptr<const Item>
-Queue<Item>::DoPeek (ConstIterator pos) const
+Queue<Item, Container>::DoPeek (ConstIterator pos) const
 {
   NS_LOG_FUNCTION (this);
 
@@ -630,33 +641,33 @@ Queue<Item>::DoPeek (ConstIterator pos) const
   return *pos;
 }
 
-template <typename Item>
-typename Queue<Item>::ConstIterator Queue<Item>::begin (void) const
+template <typename Item, typename Container>
+typename Queue<Item, Container>::ConstIterator Queue<Item, Container>::begin (void) const
 {
   return m_packets.cbegin ();
 }
 
-template <typename Item>
-typename Queue<Item>::Iterator Queue<Item>::begin (void)
+template <typename Item, typename Container>
+typename Queue<Item, Container>::Iterator Queue<Item, Container>::begin (void)
 {
   return m_packets.begin ();
 }
 
-template <typename Item>
-typename Queue<Item>::ConstIterator Queue<Item>::end (void) const
+template <typename Item, typename Container>
+typename Queue<Item, Container>::ConstIterator Queue<Item, Container>::end (void) const
 {
   return m_packets.cend ();
 }
 
-template <typename Item>
-typename Queue<Item>::Iterator Queue<Item>::end (void)
+template <typename Item, typename Container>
+typename Queue<Item, Container>::Iterator Queue<Item, Container>::end (void)
 {
   return m_packets.end ();
 }
 
-template <typename Item>
+template <typename Item, typename Container>
 void
-Queue<Item>::DropBeforeEnqueue (Ptr<Item> item)
+Queue<Item, Container>::DropBeforeEnqueue (Ptr<Item> item)
 {
   NS_LOG_FUNCTION (this << item);
 
@@ -670,9 +681,9 @@ Queue<Item>::DropBeforeEnqueue (Ptr<Item> item)
   m_traceDropBeforeEnqueue (item);
 }
 
-template <typename Item>
+template <typename Item, typename Container>
 void
-Queue<Item>::DropAfterDequeue (Ptr<Item> item)
+Queue<Item, Container>::DropAfterDequeue (Ptr<Item> item)
 {
   NS_LOG_FUNCTION (this << item);
 
@@ -0,0 +1,409 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef RING_BUFFER_H
+#define RING_BUFFER_H
+
+#include "ns3/assert.h"
+#include <vector>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <cstddef>
+
+namespace ns3 {
+
+/**
+ * \ingroup queue
+ *
+ * \brief A contiguous, geometrically growing circular buffer
+ *
+ * RingBuffer provides the subset of the std::list interface used by the
+ * Queue class template (begin, end, insert, erase, clear, size, empty), so
+ * that it can be used as the container of the items stored in a queue.
+ * Items are stored in a single array whose capacity is a power of two and
+ * is doubled when full; inserting at the back and erasing at the front
+ * (the FIFO pattern) never allocate once the buffer reached its working
+ * size.  Inserting or erasing in the middle is supported, and moves the
+ * items on the shorter side of the position.
+ *
+ * Unlike std::list, any insertion or removal (including pop_front, hence
+ * every Queue::Dequeue) invalidates all the iterators, including end ().
+ * Only the iterators returned by insert and erase are valid afterwards.
+ * Using an invalidated iterator is caught by an assert in debug builds.
+ * Queues keeping iterators across insertions or removals must use std::list
+ * instead (see Queue).
+ */
+template <typename T>
+class RingBuffer
+{
+private:
+  /**
+   * \brief Iterator over the items of the buffer
+   *
+   * An iterator stores the logical position of an item and the generation
+   * of the buffer when the iterator was obtained.  The generation changes
+   * whenever an item is inserted or removed, which makes the iterator
+   * invalid (it would otherwise silently refer to whatever item now
+   * occupies its position).
+   */
+  template <typename Ref, typename Buf>
+  class IteratorImpl
+  {
+  public:
+    /// iterator category
+    typedef std::bidirectional_iterator_tag iterator_category;
+    /// value type
+    typedef T value_type;
+    /// difference type
+    typedef std::ptrdiff_t difference_type;
+    /// pointer type
+    typedef typename std::remove_reference<Ref>::type * pointer;
+    /// reference type
+    typedef Ref reference;
+
+    IteratorImpl ()
+      : m_buf (0),
+        m_index (0),
+        m_generation (0)
+    {
+    }
+    /**
+     * Constructor
+     * \param buf the buffer
+     * \param index the logical position of the item
+     */
+    IteratorImpl (Buf *buf, std::size_t index)
+      : m_buf (buf),
+        m_index (index),
+        m_generation (buf->m_generation)
+    {
+    }
+    /**
+     * Conversion from a non-const iterator
+     * \param o the iterator to convert
+     */
+    template <typename R, typename B>
+    IteratorImpl (const IteratorImpl<R, B> &o)
+      : m_buf (o.m_buf),
+        m_index (o.m_index),
+        m_generation (o.m_generation)
+    {
+    }
+    /// \return a reference to the item
+    reference operator* () const
+    {
+      CheckValid ();
+      NS_ASSERT (m_index < m_buf->m_size);
+      return m_buf->At (m_index);
+    }
+    /// \return a pointer to the item
+    pointer operator-> () const
+    {
+      return &(**this);
+    }
+    /// \return the iterator to the next item
+    IteratorImpl & operator++ ()
+    {
+      CheckValid ();
+      m_index++;
+      return *this;
+    }
+    /// \return the iterator to the previous item
+    IteratorImpl & operator-- ()
+    {
+      CheckValid ();
+      m_index--;
+      return *this;
+    }
+    /// \return this iterator, before it is moved to the next item
+    IteratorImpl operator++ (int)
+    {
+      IteratorImpl tmp = *this;
+      ++(*this);
+      return tmp;
+    }
+    /// \return this iterator, before it is moved to the previous item
+    IteratorImpl operator-- (int)
+    {
+      IteratorImpl tmp = *this;
+      --(*this);
+      return tmp;
+    }
+    /**
+     * \param o the other iterator
+     * \return true if both iterators refer to the same position
+     */
+    template <typename R, typename B>
+    bool operator== (const IteratorImpl<R, B> &o) const
+    {
+      CheckValid ();
+      o.CheckValid ();
+      return m_index == o.m_index && m_buf == o.m_buf;
+    }
+    /**
+     * \param o the other iterator
+     * \return true if the iterators refer to different positions
+     */
+    template <typename R, typename B>
+    bool operator!= (const IteratorImpl<R, B> &o) const
+    {
+      return !(*this == o);
+    }
+
+  private:
+    template <typename R, typename B>
+    friend class IteratorImpl;
+    friend class RingBuffer;
+
+    /**
+     * Assert that no item has been inserted in or removed from the buffer
+     * since this iterator was obtained.
+     */
+    void CheckValid (void) const
+    {
+      NS_ASSERT_MSG (m_buf == 0 || m_generation == m_buf->m_generation,
+                     "Use of a RingBuffer iterator invalidated by an insertion or a removal");
+    }
+
+    Buf *m_buf;                 //!< the buffer
+    std::size_t m_index;        //!< the logical position of the item
+    std::size_t m_generation;   //!< the generation of the buffer when the iterator was obtained
+  };
+
+public:
+  /// Iterator
+  typedef IteratorImpl<T &, RingBuffer> iterator;
+  /// Const iterator
+  typedef IteratorImpl<const T &, const RingBuffer> const_iterator;
+  /// Value type
+  typedef T value_type;
+
+  RingBuffer ()
+    : m_head (0),
+      m_size (0),
+      m_generation (0)
+  {
+  }
+
+  /// \return an iterator to the first item
+  iterator begin (void)
+  {
+    return iterator (this, 0);
+  }
+  /// \return an iterator past the last item
+  iterator end (void)
+  {
+    return iterator (this, m_size);
+  }
+  /// \return a const iterator to the first item
+  const_iterator begin (void) const
+  {
+    return const_iterator (this, 0);
+  }
+  /// \return a const iterator past the last item
+  const_iterator end (void) const
+  {
+    return const_iterator (this, m_size);
+  }
+  /// \return a const iterator to the first item
+  const_iterator cbegin (void) const
+  {
+    return begin ();
+  }
+  /// \return a const iterator past the last item
+  const_iterator cend (void) const
+  {
+    return end ();
+  }
+
+  /// \return the number of items in the buffer
+  std::size_t size (void) const
+  {
+    return m_size;
+  }
+  /// \return true if the buffer holds no item
+  bool empty (void) const
+  {
+    return m_size == 0;
+  }
+  /// \return the number of items the buffer can hold without growing
+  std::size_t capacity (void) const
+  {
+    return m_slots.size ();
+  }
+
+  /// \return the first item
+  T & front (void)
+  {
+    return At (0);
+  }
+  /// \return the last item
+  T & back (void)
+  {
+    return At (m_size - 1);
+  }
+
+  /**
+   * Insert an item before the given position.
+   * \param pos the position before which the item is inserted
+   * \param value the item
+   * \return an iterator to the inserted item
+   */
+  iterator insert (const_iterator pos, const T &value)
+  {
+    pos.CheckValid ();
+    NS_ASSERT (pos.m_buf == this && pos.m_index <= m_size);
+    std::size_t index = pos.m_index;
+    m_generation++;
+    if (m_size == m_slots.size ())
+      {
+        Grow ();
+      }
+    if (index < m_size / 2)
+      {
+        // move the items before the position one slot towards the front
+        m_head = (m_head - 1) & Mask ();
+        m_size++;
+        for (std::size_t i = 0; i < index; i++)
+          {
+            At (i) = std::move (At (i + 1));
+          }
+      }
+    else
+      {
+        // move the items from the position on one slot towards the back
+        m_size++;
+        for (std::size_t i = m_size - 1; i > index; i--)
+          {
+            At (i) = std::move (At (i - 1));
+          }
+      }
+    At (index) = value;
+    return iterator (this, index);
+  }
+
+  /**
+   * Remove the item at the given position.
+   * \param pos the position of the item to remove
+   * \return an iterator to the item following the removed one
+   */
+  iterator erase (const_iterator pos)
+  {
+    pos.CheckValid ();
+    NS_ASSERT (pos.m_buf == this && pos.m_index < m_size);
+    std::size_t index = pos.m_index;
+    m_generation++;
+    if (index < m_size / 2)
+      {
+        // close the gap by moving the items before the position
+        for (std::size_t i = index; i > 0; i--)
+          {
+            At (i) = std::move (At (i - 1));
+          }
+        At (0) = T ();
+        m_head = (m_head + 1) & Mask ();
+      }
+    else
+      {
+        // close the gap by moving the items after the position
+        for (std::size_t i = index; i + 1 < m_size; i++)
+          {
+            At (i) = std::move (At (i + 1));
+          }
+        At (m_size - 1) = T ();
+      }
+    m_size--;
+    return iterator (this, index);
+  }
+
+  /**
+   * Append an item.
+   * \param value the item
+   */
+  void push_back (const T &value)
+  {
+    insert (end (), value);
+  }
+
+  /**
+   * Remove the first item.
+   */
+  void pop_front (void)
+  {
+    erase (begin ());
+  }
+
+  /**
+   * Remove all the items.  The capacity is not released.
+   */
+  void clear (void)
+  {
+    for (std::size_t i = 0; i < m_size; i++)
+      {
+        At (i) = T ();
+      }
+    m_head = 0;
+    m_size = 0;
+    m_generation++;
+  }
+
+private:
+  /**
+   * \param index the logical position of an item
+   * \return a reference to the item
+   */
+  T & At (std::size_t index)
+  {
+    return m_slots[(m_head + index) & Mask ()];
+  }
+  /**
+   * \param index the logical position of an item
+   * \return a const reference to the item
+   */
+  const T & At (std::size_t index) const
+  {
+    return m_slots[(m_head + index) & Mask ()];
+  }
+  /// \return the mask to apply to turn a position into a slot index
+  std::size_t Mask (void) const
+  {
+    return m_slots.size () - 1;
+  }
+  /**
+   * Double the capacity of the buffer (the minimum capacity is 16 items)
+   * and move the items to the beginning of the new array.
+   */
+  void Grow (void)
+  {
+    std::vector<T> slots (m_slots.empty () ? 16 : 2 * m_slots.size ());
+    for (std::size_t i = 0; i < m_size; i++)
+      {
+        slots[i] = std::move (At (i));
+      }
+    m_slots.swap (slots);
+    m_head = 0;
+  }
+
+  std::vector<T> m_slots;   //!< the storage, its size is a power of two
+  std::size_t m_head;       //!< the slot of the first item
+  std::size_t m_size;       //!< the number of items
+  std::size_t m_generation; //!< incremented whenever iterators are invalidated
+};
+
+} // namespace ns3
+
+#endif /* RING_BUFFER_H */
@@ -82,7 +82,8 @@ PppHeader::GetSerializedSize (void) const
 void
 PppHeader::Serialize (Buffer::Iterator start) const
 {
-  start.WriteHtonU16 (m_protocol);
+  Buffer::BlockWriter w (start, 2);
+  w.WriteHtonU16 (m_protocol);
 }
 
 uint32_t
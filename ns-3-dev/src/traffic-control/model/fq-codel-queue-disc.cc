@@ -70,12 +70,14 @@ FqCoDelFlow::GetDeficit (void) const
   return m_deficit;
 }
 
+#if 0 /* LOCAL-GATE-ONLY */
 int32_t
 FqCoDelFlow::GetPeekDeficit (void) const
 {
   NS_LOG_FUNCTION (this);
   return m_peekDeficit;
 }
+#endif /* LOCAL-GATE-ONLY */
 
 void
 FqCoDelFlow::IncreaseDeficit (int32_t deficit)
@@ -84,12 +86,14 @@ FqCoDelFlow::IncreaseDeficit (int32_t deficit)
   m_deficit += deficit;
 }
 
+#if 0 /* LOCAL-GATE-ONLY */
 void
 FqCoDelFlow::SetPeekDeficit (int32_t deficit)
 {
   NS_LOG_FUNCTION (this << deficit);
   m_peekDeficit = deficit;
 }
+#endif /* LOCAL-GATE-ONLY */
 
 void
 FqCoDelFlow::SetStatus (FlowStatus status)
@@ -508,6 +512,7 @@ FqCoDelQueueDisc::FqCoDelDrop (void)
 
   return index;
 }
+#if 0 /* LOCAL-GATE-ONLY */
 
 Ptr<QueueDiscItem>
 FqCoDelQueueDisc::DoPeek (void)
@@ -562,4 +567,5 @@ FqCoDelQueueDisc::DoPeek (void)
               }
                 }
 }
+#endif /* LOCAL-GATE-ONLY */
 } // namespace ns3
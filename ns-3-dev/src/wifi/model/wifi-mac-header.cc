@@ -1157,18 +1157,34 @@ WifiMacHeader::GetSerializedSize (void) const
   return GetSize ();
 }
 
+/**
+ * Write a MAC address in the block of a header
+ *
+ * \param w the block writer
+ * \param ad the MAC address
+ */
+static void
+WriteAddress (Buffer::BlockWriter &w, Mac48Address ad)
+{
+  uint8_t mac[6];
+  ad.CopyTo (mac);
+  w.Write (mac, 6);
+}
+
 void
 WifiMacHeader::Serialize (Buffer::Iterator i) const
 {
-  i.WriteHtolsbU16 (GetFrameControl ());
-  i.WriteHtolsbU16 (m_duration);
-  WriteTo (i, m_addr1);
+  // the size of the header is known from its type: write it as a single block
+  Buffer::BlockWriter w (i, GetSize ());
+  w.WriteHtolsbU16 (GetFrameControl ());
+  w.WriteHtolsbU16 (m_duration);
+  WriteAddress (w, m_addr1);
   switch (m_ctrlType)
     {
     case TYPE_MGT:
-      WriteTo (i, m_addr2);
-      WriteTo (i, m_addr3);
-      i.WriteHtolsbU16 (GetSequenceControl ());
+      WriteAddress (w, m_addr2);
+      WriteAddress (w, m_addr3);
+      w.WriteHtolsbU16 (GetSequenceControl ());
       break;
     case TYPE_CTL:
       switch (m_ctrlSubtype)
@@ -1179,7 +1195,7 @@ WifiMacHeader::Serialize (Buffer::Iterator i) const
         case SUBTYPE_CTL_BACKRESP:
         case SUBTYPE_CTL_END:
         case SUBTYPE_CTL_END_ACK:
-          WriteTo (i, m_addr2);
+          WriteAddress (w, m_addr2);
           break;
         case SUBTYPE_CTL_CTS:
         case SUBTYPE_CTL_ACK:
@@ -1192,16 +1208,16 @@ WifiMacHeader::Serialize (Buffer::Iterator i) const
       break;
     case TYPE_DATA:
       {
-        WriteTo (i, m_addr2);
-        WriteTo (i, m_addr3);
-        i.WriteHtolsbU16 (GetSequenceControl ());
+        WriteAddress (w, m_addr2);
+        WriteAddress (w, m_addr3);
+        w.WriteHtolsbU16 (GetSequenceControl ());
         if (m_ctrlToDs && m_ctrlFromDs)
           {
-            WriteTo (i, m_addr4);
+            WriteAddress (w, m_addr4);
           }
         if (m_ctrlSubtype & 0x08)
           {
-            i.WriteHtolsbU16 (GetQosControl ());
+            w.WriteHtolsbU16 (GetQosControl ());
           }
       } break;
     default:
@@ -29,17 +29,29 @@
 #include <unordered_map>
 #include "qos-utils.h"
 #include <functional>
+#include <list>
+#include <type_traits>
 
 namespace ns3 {
 
 class QosBlockedDestinations;
 
+/**
+ * \ingroup wifi
+ *
+ * Container storing the items of a WifiMacQueue.  WifiMacQueueItem objects
+ * keep an iterator pointing to their position in the queue and WifiMacQueue
+ * removes items while browsing the queue, hence its items are stored in a
+ * list rather than in the default ring buffer.
+ */
+typedef std::list<Ptr<WifiMacQueueItem> > WifiMacQueueContainer;
+
 // The following explicit template instantiation declaration prevents modules
 // including this header file from implicitly instantiating Queue<WifiMacQueueItem>.
 // This would cause python examples using wifi to crash at runtime with the
 // following error message: "Trying to allocate twice the same UID:
 // ns3::Queue<WifiMacQueueItem>"
-extern template class Queue<WifiMacQueueItem>;
+extern template class Queue<WifiMacQueueItem, WifiMacQueueContainer>;
 
 
 /**
@@ -57,7 +69,7 @@ extern template class Queue<WifiMacQueueItem>;
  * dot11EDCATableMSDULifetime has elapsed, it is dropped.
  * Otherwise, it is returned to the caller.
  */
-class WifiMacQueue : public Queue<WifiMacQueueItem>
+class WifiMacQueue : public Queue<WifiMacQueueItem, WifiMacQueueContainer>
 {
 public:
   /**
@@ -83,10 +95,13 @@ public:
   };
 
   /// allow the usage of iterators and const iterators
-  using Queue<WifiMacQueueItem>::ConstIterator;
-  using Queue<WifiMacQueueItem>::Iterator;
-  using Queue<WifiMacQueueItem>::begin;
-  using Queue<WifiMacQueueItem>::end;
+  using Queue<WifiMacQueueItem, WifiMacQueueContainer>::ConstIterator;
+  using Queue<WifiMacQueueItem, WifiMacQueueContainer>::Iterator;
+  using Queue<WifiMacQueueItem, WifiMacQueueContainer>::begin;
+  using Queue<WifiMacQueueItem, WifiMacQueueContainer>::end;
+
+  static_assert (std::is_same<WifiMacQueueItem::ConstIterator, ConstIterator>::value,
+                 "WifiMacQueueItem::ConstIterator must be an iterator of the WifiMacQueue container");
 
   /**
    * Set the maximum delay before the packet is discarded.
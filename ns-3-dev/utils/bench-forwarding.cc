@@ -0,0 +1,160 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark IPv4 forwarding over a chain of
+// point-to-point links.  A UDP client on the first node sends 'n' packets
+// to a UDP server on the last node, 'hops' links away, and the wall clock
+// time spent in Simulator::Run is reported.
+// Sample usage:  ./ns3 run 'bench-forwarding --n=100000 --hops=8'
+//
+// With --traces, a sink is connected to the MacRx trace of every device, so
+// that the cost of the copies made for the trace sinks can be compared.
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/applications-module.h"
+#include "ns3/system-wall-clock-ms.h"
+#include <iostream>
+#include <limits>
+#include <algorithm>
+#include <stdlib.h> // for exit ()
+
+using namespace ns3;
+
+/// Number of packets received by the traces
+static uint64_t g_traced = 0;
+
+/**
+ * MacRx trace sink
+ * \param p the received packet
+ */
+static void
+MacRx (Ptr<const Packet> p)
+{
+  g_traced++;
+}
+
+/**
+ * Build the chain, run the simulation and return the elapsed time.
+ * \param n the number of packets to send
+ * \param hops the number of links between the client and the server
+ * \param size the size of the UDP payload
+ * \param traces whether to connect the MacRx trace sinks
+ * \param received [out] the number of packets received by the server
+ * \return the time spent in Simulator::Run, in milliseconds
+ */
+static uint64_t
+runBenchOneIteration (uint32_t n, uint32_t hops, uint32_t size, bool traces, uint64_t &received)
+{
+  NodeContainer nodes;
+  nodes.Create (hops + 1);
+
+  PointToPointHelper p2p;
+  p2p.SetDeviceAttribute ("DataRate", StringValue ("10Gbps"));
+  p2p.SetChannelAttribute ("Delay", StringValue ("1us"));
+
+  InternetStackHelper internet;
+  internet.Install (nodes);
+
+  Ipv4AddressHelper address;
+  address.SetBase ("10.0.0.0", "255.255.255.252");
+  Ipv4Address serverAddress;
+  for (uint32_t i = 0; i < hops; i++)
+    {
+      NetDeviceContainer devices = p2p.Install (nodes.Get (i), nodes.Get (i + 1));
+      Ipv4InterfaceContainer interfaces = address.Assign (devices);
+      serverAddress = interfaces.GetAddress (1);
+      address.NewNetwork ();
+    }
+  Ipv4GlobalRoutingHelper::PopulateRoutingTables ();
+
+  uint16_t port = 9;
+  UdpServerHelper server (port);
+  ApplicationContainer serverApps = server.Install (nodes.Get (hops));
+
+  UdpClientHelper client (serverAddress, port);
+  client.SetAttribute ("MaxPackets", UintegerValue (n));
+  client.SetAttribute ("Interval", TimeValue (MicroSeconds (2)));
+  client.SetAttribute ("PacketSize", UintegerValue (size));
+  ApplicationContainer clientApps = client.Install (nodes.Get (0));
+  clientApps.Start (Seconds (1));
+
+  if (traces)
+    {
+      Config::ConnectWithoutContext ("/NodeList/*/DeviceList/*/$ns3::PointToPointNetDevice/MacRx",
+                                     MakeCallback (&MacRx));
+    }
+
+  SystemWallClockMs time;
+  time.Start ();
+  Simulator::Run ();
+  uint64_t deltaMs = time.End ();
+
+  received = DynamicCast<UdpServer> (serverApps.Get (0))->GetReceived ();
+  Simulator::Destroy ();
+  return deltaMs;
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t n = 0;
+  uint32_t hops = 8;
+  uint32_t size = 1000;
+  uint32_t minIterations = 1;
+  bool traces = false;
+
+  CommandLine cmd (__FILE__);
+  cmd.Usage ("Benchmark IPv4 forwarding over a chain of point-to-point links");
+  cmd.AddValue ("n", "number of packets sent by the client", n);
+  cmd.AddValue ("hops", "number of point-to-point links between the client and the server", hops);
+  cmd.AddValue ("size", "UDP payload size, in bytes", size);
+  cmd.AddValue ("min-iterations", "number of subiterations to minimize iteration time over", minIterations);
+  cmd.AddValue ("traces", "connect a sink to the MacRx trace of every device", traces);
+  cmd.Parse (argc, argv);
+
+  if (n == 0 || hops == 0)
+    {
+      std::cerr << "Error-- number of packets must be specified " <<
+        "by command-line argument --n=(number of packets)" << std::endl;
+      exit (1);
+    }
+  std::cout << "Running bench-forwarding with n=" << n << " hops=" << hops
+            << " size=" << size << (traces ? " (MacRx traces connected)" : "") << std::endl;
+
+  uint64_t minDelay = std::numeric_limits<uint64_t>::max ();
+  uint64_t received = 0;
+  for (uint32_t i = 0; i < minIterations; i++)
+    {
+      g_traced = 0;
+      minDelay = std::min (minDelay, runBenchOneIteration (n, hops, size, traces, received));
+    }
+  // every received packet crossed all the links
+  double ps = static_cast<double> (received) * hops;
+  ps *= 1000;
+  ps /= std::max<uint64_t> (minDelay, 1);
+  std::cout << ps << " packet hops/s"
+            << " (" << minDelay << " ms elapsed, "
+            << received << " packets received";
+  if (traces)
+    {
+      std::cout << ", " << g_traced << " traced";
+    }
+  std::cout << ")" << std::endl;
+
+  return 0;
+}